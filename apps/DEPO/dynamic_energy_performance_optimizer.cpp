@@ -42,6 +42,36 @@ parseArgs(po::variables_map& map)
             std::cout << "Using Golden Section Search algorithm as selected.\n";
             search = SearchType::GOLDEN_SECTION_SEARCH;
         }
+        else if (map.count("pkg-dram"))
+        {
+            map.erase("pkg-dram");
+            std::cout << "Using joint PKG and DRAM Coordinate Descent algorithm as selected.\n";
+            search = SearchType::PKG_DRAM_COORDINATE_DESCENT;
+        }
+        else if (map.count("model"))
+        {
+            map.erase("model");
+            std::cout << "Using Model-based Search algorithm as selected.\n";
+            search = SearchType::MODEL_BASED_SEARCH;
+        }
+        else if (map.count("online"))
+        {
+            map.erase("online");
+            std::cout << "Using Online Perturb and Observe tuning as selected.\n";
+            search = SearchType::ONLINE_PERTURB_AND_OBSERVE;
+        }
+        else if (map.count("ngss"))
+        {
+            map.erase("ngss");
+            std::cout << "Using Noise-aware Golden Section Search algorithm as selected.\n";
+            search = SearchType::NOISE_AWARE_GOLDEN_SECTION_SEARCH;
+        }
+        else if (map.count("bo"))
+        {
+            map.erase("bo");
+            std::cout << "Using Bayesian Optimization algorithm as selected.\n";
+            search = SearchType::BAYESIAN_OPTIMIZATION;
+        }
         else if (map.count("ls"))
         {
             map.erase("ls");
@@ -97,6 +127,11 @@ void cleanArgv(int& argc, char* argv[])
         const auto flag = std::string(argv[idx]);
         if (flag == "--ls"  ||
             flag == "--gss" ||
+            flag == "--bo"  ||
+            flag == "--ngss" ||
+            flag == "--online" ||
+            flag == "--pkg-dram" ||
+            flag == "--model" ||
             flag == "--en"  ||
             flag == "--edp" ||
             flag == "--eds" ||
@@ -163,12 +198,19 @@ int main (int argc, char *argv[])
     desc.add_options()
         ("help", "produce help message")
         ("gss", "use Golden Section Search algorithm")
+        ("ngss", "use Golden Section Search algorithm re-measuring candidates with overlapping confidence intervals")
         ("ls", "use Linear search algorithm")
+        ("pkg-dram", "search PKG and DRAM power limits jointly minimizing combined PKG+DRAM energy metric")
+        ("model", "use Model-based Search, power cap predicted by a power-performance model fitted from 3 probes")
+        ("online", "tune the cap continuously during execution with perturb and observe instead of separate tuning phases")
+        ("bo", "use Bayesian Optimization (Gaussian process) search algorithm")
         ("en", "use Energy metric")
         ("edp", "use Energy Delay Product metric")
         ("eds", "use Energy SumDelay  metric")
         ("no-tuning", "run app only checking the power and energy consumption")
         ("gpu", po::value<int>(), "use GPU backend for card with specified ID")
+        ("node", "with GPU backend account also for the host CPU energy and report node energy")
+        ("pcm", "count CPU instructions system-wide with PCM instead of per-process perf_event counters")
     ;
     po::variables_map optionsMap;
     po::parsed_options parsed = po::command_line_parser(argc, argv)
@@ -211,9 +253,14 @@ int main (int argc, char *argv[])
 
 
     std::shared_ptr<Device> device;
+    std::vector<std::shared_ptr<Device>> auxiliaryDevices;
     if (gpuID.has_value())
     {
         device = std::make_shared<CudaDevice>(gpuID.value());
+        if (optionsMap.count("node"))
+        {
+            auxiliaryDevices.push_back(std::make_shared<IntelDevice>());
+        }
 
         int e1 = setenv("INJECTION_KERNEL_COUNT", "1", 1);
         std::string path = readPathInfo();
@@ -232,10 +279,11 @@ int main (int argc, char *argv[])
     }
     else
     {
-        device = std::make_shared<IntelDevice>();
+        device = std::make_shared<IntelDevice>(
+            optionsMap.count("pcm") ? PerfCounterBackend::PCM : PerfCounterBackend::PERF_EVENT);
     }
 
-    std::unique_ptr<Eco> eco = std::make_unique<Eco>(device);
+    std::unique_ptr<Eco> eco = std::make_unique<Eco>(device, auxiliaryDevices);
     std::stringstream ssout;
     std::stringstream applicationCommand;
     for (int i=1; i<argc; i++) {
@@ -0,0 +1,102 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// Microbenchmark of the RAPL-update-aligned sampling.
+//
+// Measures the PKG power of a steady load (one spinning thread per logical CPU)
+// in many back-to-back windows of a few milliseconds, once with samples taken at
+// arbitrary phase of the ~1 ms RAPL counter update and once with samples aligned
+// to the update edge (Rapl::setAlignedSampling). As the true power is constant,
+// the spread of per-window readings is the measurement error of the window.
+//
+// Usage: sudo ./RaplAlignmentBenchmark [windows_per_size] [idle]
+
+#include "devices/intel_device.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct WindowStats
+{
+    double mean {0.0};
+    double stdDev {0.0};
+};
+
+static WindowStats measureWindows(Rapl& rapl, bool aligned, int windowMs, int numWindows)
+{
+    rapl.setAlignedSampling(aligned);
+    std::vector<double> readings;
+    readings.reserve(numWindows);
+    rapl.sample();
+    for (int i = 0; i < numWindows; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(windowMs));
+        rapl.sample();
+        readings.push_back(rapl.pkg_current_power());
+    }
+    WindowStats result;
+    for (auto&& r : readings) result.mean += r;
+    result.mean /= readings.size();
+    for (auto&& r : readings) result.stdDev += (r - result.mean) * (r - result.mean);
+    result.stdDev = std::sqrt(result.stdDev / (readings.size() - 1));
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    const int numWindows = argc > 1 ? std::stoi(argv[1]) : 500;
+    const bool idle = argc > 2 && std::string(argv[2]) == "idle";
+
+    IntelDevice device;
+    Rapl rapl(device.getPkgToFirstCoreMap().front(), device.getAvailablePowerDomains());
+
+    std::atomic<bool> stop {false};
+    std::vector<std::thread> load;
+    if (!idle)
+    {
+        for (unsigned i = 0; i < std::thread::hardware_concurrency(); i++)
+        {
+            load.emplace_back([&stop] {
+                volatile double x = 1.0;
+                while (!stop.load(std::memory_order_relaxed)) x = x * 1.0000001;
+            });
+        }
+        // let the power settle
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+    }
+
+    std::cout << "\n# windows per size: " << numWindows << ", load: " << (idle ? "idle" : "all CPUs busy") << "\n"
+              << "window[ms]\tmean[W]\t\tstddev unaligned[W]\tstddev aligned[W]\terror reduction\n"
+              << std::fixed << std::setprecision(3);
+    for (int windowMs : {2, 5, 10, 20, 50, 100})
+    {
+        const auto unaligned = measureWindows(rapl, false, windowMs, numWindows);
+        const auto aligned = measureWindows(rapl, true, windowMs, numWindows);
+        std::cout << windowMs << "\t\t" << unaligned.mean << "\t\t" << unaligned.stdDev << "\t\t\t"
+                  << aligned.stdDev << "\t\t\t" << std::setprecision(1)
+                  << 100.0 * (1.0 - aligned.stdDev / unaligned.stdDev) << "%\n" << std::setprecision(3);
+    }
+
+    stop = true;
+    for (auto&& t : load) t.join();
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// Microbenchmark of the RAPL sampling path.
+//
+// Compares the number of samples per second that can be taken for all the packages
+// when the MSR file is opened and closed on every sample (the way Rapl::sample()
+// used to work) against the persistent per-package MSR handles with batched
+// energy status reads used by Rapl::sample() now.
+//
+// Usage: sudo ./RaplSamplingBenchmark [number_of_samples]
+
+#include "devices/intel_device.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+template <class F>
+static double measureSamplesPerSecond(F&& sampleAllPackages, int numSamples)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < numSamples; i++)
+    {
+        sampleAllPackages();
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return numSamples / elapsed;
+}
+
+int main(int argc, char* argv[])
+{
+    const int numSamples = argc > 1 ? std::stoi(argv[1]) : 100000;
+
+    IntelDevice device;
+    const auto cores = device.getPkgToFirstCoreMap();
+    const auto domains = device.getAvailablePowerDomains();
+
+    std::vector<Domain> sampledDomains {Domain::PKG, Domain::PP0};
+    if (domains.pp1_) sampledDomains.push_back(Domain::PP1);
+    if (domains.dram_) sampledDomains.push_back(Domain::DRAM);
+
+    // previous implementation: open, read all the domains and close for every package
+    volatile uint64_t sink = 0;
+    const auto legacy = measureSamplesPerSecond([&] {
+        for (auto&& core : cores)
+        {
+            MSR msr(core);
+            for (auto&& domain : sampledDomains)
+            {
+                sink = sink + msr.getEnergyStatus(domain);
+            }
+        }
+    }, numSamples);
+
+    std::vector<Rapl> raplVec;
+    raplVec.reserve(cores.size());
+    for (auto&& core : cores)
+    {
+        raplVec.emplace_back(core, domains);
+    }
+    const auto persistent = measureSamplesPerSecond([&] {
+        for (auto&& rapl : raplVec)
+        {
+            rapl.sample();
+        }
+    }, numSamples);
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "\n# packages: " << cores.size() << ", domains per package: " << sampledDomains.size()
+              << ", samples: " << numSamples << "\n"
+              << "open/read/close per sample:\t" << legacy << " samples/s\n"
+              << "persistent MSR handles:\t\t" << persistent << " samples/s\n"
+              << std::setprecision(2)
+              << "speedup:\t\t\t" << persistent / legacy << "x\n";
+    return 0;
+}
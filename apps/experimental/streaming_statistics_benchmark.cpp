@@ -0,0 +1,137 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+// Microbenchmark of the streaming estimators.
+//
+// Compares the time per sample of the way Trigger uses DataFilter (store a data
+// point, read the SMA and the cleaned relative error) for the previous implementation,
+// which rescanned the whole window on every call, against DataFilter built on the
+// O(1) estimators from streaming_estimators.hpp, for window sizes from 100 to 100k.
+// Then reports the cost of every estimator alone.
+//
+// Usage: ./StreamingStatisticsBenchmark [number_of_samples]
+
+#include "data_structures/data_filter.hpp"
+#include "data_structures/streaming_estimators.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// DataFilter before it was rebuilt on the streaming estimators
+class LegacyDataFilter {
+public:
+    LegacyDataFilter(unsigned size) : filterSize_(size) {}
+
+    double getSMA() const { return getSum() / data_.size(); }
+
+    double getCleanedRelativeError() const
+    {
+        const auto minmax = std::minmax_element(data_.begin(), data_.end());
+        auto cleanedSMA = (getSum() - (*minmax.first + *minmax.second)) / (data_.size() - 2);
+        return (*minmax.second - *minmax.first) / cleanedSMA;
+    }
+
+    void storeDataPoint(double dataPoint)
+    {
+        if (data_.size() == filterSize_) {
+            data_[activeIndex_] = dataPoint;
+            activeIndex_ = activeIndex_ + 1 == filterSize_ ? 0 : activeIndex_ + 1;
+        } else {
+            data_.push_back(dataPoint);
+        }
+    }
+
+private:
+    double getSum() const
+    {
+        double acc = 0.0;
+        for (auto&& dataPoint : data_) acc += dataPoint;
+        return acc;
+    }
+
+    std::vector<double> data_;
+    unsigned filterSize_;
+    unsigned activeIndex_ {0};
+};
+
+template <class F>
+static double measureNanoSecondsPerSample(const std::vector<double>& samples, F&& process)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (auto&& sample : samples)
+    {
+        process(sample);
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+    return elapsed / samples.size();
+}
+
+int main(int argc, char* argv[])
+{
+    const int numSamples = argc > 1 ? std::stoi(argv[1]) : 200000;
+
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(100.0, 5.0);
+    std::vector<double> samples(numSamples);
+    for (auto&& sample : samples) sample = noise(generator);
+
+    volatile double sink = 0.0;
+    double maxDifference = 0.0;
+    std::cout << std::fixed << std::setprecision(1)
+              << "\n# samples: " << numSamples << "\n"
+              << "window\tlegacy [ns/sample]\tstreaming [ns/sample]\tspeedup\n";
+    for (unsigned window : {100u, 1000u, 10000u, 100000u})
+    {
+        // the legacy filter is quadratic, limit its samples to keep the run short
+        const std::vector<double> legacySamples(samples.begin(), samples.begin() + std::min<std::size_t>(samples.size(), 2 * window + 20000));
+        LegacyDataFilter legacy(window);
+        const auto legacyTime = measureNanoSecondsPerSample(legacySamples, [&](double x) {
+            legacy.storeDataPoint(x);
+            sink = sink + legacy.getSMA() + legacy.getCleanedRelativeError();
+        });
+        DataFilter streaming(window);
+        const auto streamingTime = measureNanoSecondsPerSample(legacySamples, [&](double x) {
+            streaming.storeDataPoint(x);
+            sink = sink + streaming.getSMA() + streaming.getCleanedRelativeError();
+        });
+        maxDifference = std::max(maxDifference, std::abs(legacy.getSMA() - streaming.getSMA()));
+        maxDifference = std::max(maxDifference, std::abs(legacy.getCleanedRelativeError() - streaming.getCleanedRelativeError()));
+        std::cout << window << "\t" << legacyTime << "\t\t\t" << streamingTime << "\t\t\t"
+                  << legacyTime / streamingTime << "x\n";
+    }
+    std::cout << std::scientific << std::setprecision(2)
+              << "max difference of the final results: " << maxDifference << "\n";
+
+    const unsigned window = 10000;
+    MovingAverage sma(window);
+    ExponentialMovingAverage ewma(0.1);
+    StreamingStatistics welford;
+    SlidingMinMax extrema(window);
+    HampelFilter hampel;
+    std::cout << std::fixed << std::setprecision(1) << "\nestimator (window " << window << ")\t[ns/sample]\n"
+              << "MovingAverage\t\t\t" << measureNanoSecondsPerSample(samples, [&](double x) { sma.add(x); sink = sink + sma.getMean(); }) << "\n"
+              << "ExponentialMovingAverage\t" << measureNanoSecondsPerSample(samples, [&](double x) { sink = sink + ewma.add(x); }) << "\n"
+              << "StreamingStatistics\t\t" << measureNanoSecondsPerSample(samples, [&](double x) { welford.add(x); sink = sink + welford.getVariance(); }) << "\n"
+              << "SlidingMinMax\t\t\t" << measureNanoSecondsPerSample(samples, [&](double x) { extrema.push(x); sink = sink + extrema.getMax() - extrema.getMin(); }) << "\n"
+              << "HampelFilter (window 7)\t\t" << measureNanoSecondsPerSample(samples, [&](double x) { sink = sink + hampel.filter(x); }) << "\n";
+    return 0;
+}
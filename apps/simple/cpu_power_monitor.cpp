@@ -24,6 +24,7 @@
 #include <fstream>
 #include <iomanip>
 #include <memory>
+#include <numeric>
 
 #include "plot_builder.hpp"
 // Workaround: below two has to be included in such order to ensure no warnings
@@ -59,6 +60,7 @@ int main(int argc, char *argv[]) {
 	outfile << std::fixed << std::setprecision(3) << "curr.P\tPP0\t\tPP1\t\tDRAM\ttime\n";
 
 	m->getAllCounterStates(SysBeforeState, DummySocketStates, BeforeState);
+	ds.startBackgroundSampling(ms_pause);
 
     int fd = open("redirected_GPC.txt", O_WRONLY|O_TRUNC|O_CREAT, 0644);
     if (fd < 0) { perror("open"); abort(); }
@@ -79,9 +81,6 @@ int main(int argc, char *argv[]) {
 			int status = 1;
 			waitpid(childProcId, &status, WNOHANG);	
 			while (status) {
-				
-				usleep(ms_pause * 1000);
-
 				ds.sample();
 				outfile << ds.getCurrentPower(Domain::PKG) << "\t"
 				<< ds.getCurrentPower(Domain::PP0) << "\t"
@@ -92,17 +91,21 @@ int main(int argc, char *argv[]) {
 			}
 			wait(&status);
 
-			double totalTimeInSeconds = ds.getTimeSinceReset();
+			double totalTimeInSeconds = ds.getTimeSinceReset() / 1000.0;
+			auto domainEnergy = [&ds](Domain d) {
+				auto energyVec = ds.getTotalEnergyVec(d);
+				return std::accumulate(energyVec.begin(), energyVec.end(), 0.0);
+			};
 
 			std::cout << std::endl
 				<< "\t PKG Total Energy:\t" << ds.getEnergySinceReset() << " J" << std::endl
-				// << "\t PP0 Total Energy:\t" << ds.getEnergySinceReset(Domain::PP0) << " J" << std::endl
-				// << "\t PP1 Total Energy:\t" << ds.getEnergySinceReset(Domain::PP1) << " J" << std::endl
-				// << "\tDRAM Total Energy:\t" << ds.getEnergySinceReset(Domain::DRAM) << " J" << std::endl
+				<< "\t PP0 Total Energy:\t" << domainEnergy(Domain::PP0) << " J" << std::endl
+				<< "\t PP1 Total Energy:\t" << domainEnergy(Domain::PP1) << " J" << std::endl
+				<< "\tDRAM Total Energy:\t" << domainEnergy(Domain::DRAM) << " J" << std::endl
 				<< "\t PKG Average Power:\t" << ds.getEnergySinceReset() / totalTimeInSeconds << " W" << std::endl
-				// << "\t PP0 Average Power:\t" << ds.getEnergySinceReset(Domain::PP0) / totalTimeInSeconds << " W" << std::endl
-				// << "\t PP1 Average Power:\t" << ds.getEnergySinceReset(Domain::PP1) / totalTimeInSeconds << " W" << std::endl
-				// << "\tDRAM Average Power:\t" << ds.getEnergySinceReset(Domain::DRAM) / totalTimeInSeconds << " W" << std::endl
+				<< "\t PP0 Average Power:\t" << domainEnergy(Domain::PP0) / totalTimeInSeconds << " W" << std::endl
+				<< "\t PP1 Average Power:\t" << domainEnergy(Domain::PP1) / totalTimeInSeconds << " W" << std::endl
+				<< "\tDRAM Average Power:\t" << domainEnergy(Domain::DRAM) / totalTimeInSeconds << " W" << std::endl
 				<< "\tTotal time:\t\t" << totalTimeInSeconds << " sec" << std::endl;
 		}
 	} else {
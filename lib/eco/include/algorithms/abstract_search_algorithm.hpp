@@ -17,8 +17,12 @@
 #pragma once
 
 #include <sys/wait.h>
+#include <cmath>
+#include <functional>
+#include <optional>
 #include "logging/both_stream.hpp"
 #include "logging/log.hpp"
+#include "data_structures/sequential_probability_ratio_test.hpp"
 
 
 class SearchAlgorithm
@@ -36,6 +40,33 @@ class SearchAlgorithm
       int,
       Logger&) const = 0;
 
+    /*
+      setEqualWorkWindows - candidate windows end after the work done by the reference in
+      the tuning window, or after maxWindowStretch times the tuning window at the latest
+    */
+    void setEqualWorkWindows(double maxWindowStretch)
+    {
+      equalWorkMaxWindowStretch_ = maxWindowStretch;
+    }
+
+    /*
+      setEarlyTermination - candidate windows compared with an incumbent end as soon as
+      the candidate is found worse by more than relativeMargin by the sequential test
+    */
+    void setEarlyTermination(double relativeMargin)
+    {
+      earlyTerminationMargin_ = relativeMargin;
+    }
+
+    /*
+      setPlusMetricK - k of the plus metric (MIN_M_PLUS), has to be the same as used
+      for the logs and the results, i.e., the one from the config
+    */
+    void setPlusMetricK(double k)
+    {
+      plusMetricK_ = k;
+    }
+
     static PowAndPerfResult sampleAndAccumulatePowAndPerfForGivenPeriod(
       int tuningTimeWindowInMicroSeconds,
       int powerSamplingPeriodInMilliSeconds,
@@ -43,26 +74,162 @@ class SearchAlgorithm
       Trigger& trigger,
       int& procStatus,
       int childProcID,
-      Logger& logger)
+      Logger& logger,
+      const std::function<void(PowAndPerfResult&)>& onSample = nullptr,
+      const std::function<bool(const PowAndPerfResult&)>& stopEarly = nullptr)
+    {
+      const double halfPeriodInMicroSeconds = powerSamplingPeriodInMilliSeconds * 500.0;
+      // sample() waits for the next sample taken by the background sampler,
+      // the window is closed basing on the sampled time
+      deviceState.sample();
+      auto resultAccumulator = deviceState.getCurrentPowerAndPerf();
+      if (onSample) onSample(resultAccumulator);
+
+      while (resultAccumulator.periodInSeconds_ * 1e6 + halfPeriodInMicroSeconds < tuningTimeWindowInMicroSeconds)
+      {
+        deviceState.sample();
+        auto tmp = deviceState.getCurrentPowerAndPerf(trigger);
+        logger.logPowerLogLine(deviceState, tmp);
+        if (onSample) onSample(tmp);
+        resultAccumulator += tmp;
+
+        waitpid(childProcID, &procStatus, WNOHANG);
+        if (!procStatus) break;
+        if (stopEarly && stopEarly(tmp)) break;
+      }
+
+      return resultAccumulator;
+    }
+
+    static PowAndPerfResult sampleAndAccumulatePowAndPerfForGivenWork(
+      double work,
+      int maxTuningTimeWindowInMicroSeconds,
+      int powerSamplingPeriodInMilliSeconds,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      int& procStatus,
+      int childProcID,
+      Logger& logger,
+      const std::function<void(PowAndPerfResult&)>& onSample = nullptr,
+      const std::function<bool(const PowAndPerfResult&)>& stopEarly = nullptr)
     {
-      auto pauseInMicroSeconds = powerSamplingPeriodInMilliSeconds * 1000;
-      usleep(pauseInMicroSeconds);
+      const double halfPeriodInMicroSeconds = powerSamplingPeriodInMilliSeconds * 500.0;
       deviceState.sample();
       auto resultAccumulator = deviceState.getCurrentPowerAndPerf();
+      if (onSample) onSample(resultAccumulator);
 
-      while (tuningTimeWindowInMicroSeconds > pauseInMicroSeconds)
+      while (resultAccumulator.instructionsCount_ < work &&
+             resultAccumulator.periodInSeconds_ * 1e6 + halfPeriodInMicroSeconds < maxTuningTimeWindowInMicroSeconds)
       {
-        usleep(pauseInMicroSeconds);
         deviceState.sample();
         auto tmp = deviceState.getCurrentPowerAndPerf(trigger);
         logger.logPowerLogLine(deviceState, tmp);
+        if (onSample) onSample(tmp);
         resultAccumulator += tmp;
-        tuningTimeWindowInMicroSeconds -= pauseInMicroSeconds;
 
         waitpid(childProcID, &procStatus, WNOHANG);
         if (!procStatus) break;
+        if (stopEarly && stopEarly(tmp)) break;
       }
 
       return resultAccumulator;
     }
+
+    /*
+      getCost - cost of the result relative to the reference, the lower the better
+    */
+    static double getCost(PowAndPerfResult result, const PowAndPerfResult& reference, TargetMetric metric, double plusMetricK)
+    {
+      result.checkPlusMetric(reference, plusMetricK);
+      return result.getRelativeCost(reference, metric);
+    }
+
+  protected:
+    double getCost(const PowAndPerfResult& result, const PowAndPerfResult& reference, TargetMetric metric) const
+    {
+      return getCost(result, reference, metric, plusMetricK_);
+    }
+
+    /*
+      measureTuningWindow - measures a candidate for the tuning window, or for the same
+      work as the reference in equal work mode
+    */
+    PowAndPerfResult measureTuningWindow(
+      const PowAndPerfResult& reference,
+      int tuningTimeWindowInMicroSeconds,
+      int powerSamplingPeriodInMilliSeconds,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      int& procStatus,
+      int childProcID,
+      Logger& logger,
+      const std::function<void(PowAndPerfResult&)>& onSample = nullptr,
+      const std::function<bool(const PowAndPerfResult&)>& stopEarly = nullptr) const
+    {
+      const double work = reference.getInstrPerSecond() * tuningTimeWindowInMicroSeconds / 1e6;
+      if (equalWorkMaxWindowStretch_ > 0.0 && std::isfinite(work) && work > 0.0)
+      {
+        return sampleAndAccumulatePowAndPerfForGivenWork(
+          work,
+          equalWorkMaxWindowStretch_ * tuningTimeWindowInMicroSeconds,
+          powerSamplingPeriodInMilliSeconds,
+          deviceState,
+          trigger,
+          procStatus,
+          childProcID,
+          logger,
+          onSample,
+          stopEarly);
+      }
+      return sampleAndAccumulatePowAndPerfForGivenPeriod(
+        tuningTimeWindowInMicroSeconds,
+        powerSamplingPeriodInMilliSeconds,
+        deviceState,
+        trigger,
+        procStatus,
+        childProcID,
+        logger,
+        onSample,
+        stopEarly);
+    }
+
+    /*
+      measureTuningWindowAgainstIncumbent - measureTuningWindow ended early if the candidate
+      is dominated by the incumbent in terms of the given metric (with early termination on)
+    */
+    PowAndPerfResult measureTuningWindowAgainstIncumbent(
+      const PowAndPerfResult& reference,
+      PowAndPerfResult incumbent,
+      TargetMetric metric,
+      int tuningTimeWindowInMicroSeconds,
+      int powerSamplingPeriodInMilliSeconds,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      int& procStatus,
+      int childProcID,
+      Logger& logger) const
+    {
+      if (earlyTerminationMargin_ <= 0.0)
+      {
+        return measureTuningWindow(reference, tuningTimeWindowInMicroSeconds, powerSamplingPeriodInMilliSeconds,
+                                   deviceState, trigger, procStatus, childProcID, logger);
+      }
+      SequentialProbabilityRatioTest test(getCost(incumbent, reference, metric), earlyTerminationMargin_);
+      // the first sample is passed only to onSample, the following ones to both
+      std::optional<PowAndPerfResult> window;
+      return measureTuningWindow(reference, tuningTimeWindowInMicroSeconds, powerSamplingPeriodInMilliSeconds,
+                                 deviceState, trigger, procStatus, childProcID, logger,
+                                 [&](PowAndPerfResult& sample) {
+                                   if (window) *window += sample; else window = sample;
+                                 },
+                                 [&](const PowAndPerfResult& sample) {
+                                   return test.update(getCost(sample, reference, metric), getCost(*window, reference, metric));
+                                 });
+    }
+
+    double plusMetricK_ {2.0}; // see setPlusMetricK
+
+  private:
+    double equalWorkMaxWindowStretch_ {0.0}; // 0 - windows of equal time
+    double earlyTerminationMargin_ {0.0}; // 0 - windows are never ended early
 };
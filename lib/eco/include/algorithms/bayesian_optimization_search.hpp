@@ -0,0 +1,164 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "algorithms/abstract_search_algorithm.hpp"
+#include "algorithms/gaussian_process.hpp"
+
+#include <cmath>
+#include <iomanip>
+
+
+/*
+  BayesianOptimizationSearchAlgorithm - power cap selection robust to noisy measurements
+
+  The relative cost of the target metric (see PowAndPerfResult::getRelativeCost) is
+  modelled with a Gaussian process with a noise term over the normalized power cap
+  range. The reference run is the observation at the max cap. Next cap is the one with
+  the highest expected improvement over the best posterior mean. The search stops when
+  the expected improvement gets negligible and the posterior of the best cap is
+  confident, or after MAX_WINDOWS tuning windows. Returns the cap with the lowest
+  posterior mean.
+*/
+class BayesianOptimizationSearchAlgorithm : public SearchAlgorithm
+{
+  public:
+    unsigned operator() (
+      std::shared_ptr<Device> device,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      TargetMetric metric,
+      const PowAndPerfResult& reference,
+      int& procStatus,
+      int childProcID,
+      int powerSamplingPeriodInMilliSeconds,
+      int tuningTimeWindowInMilliSeconds,
+      Logger& logger) const
+    {
+        const auto [minLimitInWatts, maxLimitInWatts] = device->getMinMaxLimitInWatts();
+        const double a = minLimitInWatts * 1e6; // micro watts
+        const double b = maxLimitInWatts * 1e6; // micro watts
+        auto toMicroWatts = [&](double x) { return int(a + x * (b - a)); };
+
+        GaussianProcess gp;
+        // reference is measured with the default, i.e., the max cap
+        gp.addObservation(1.0, 1.0);
+
+        int windows = 0;
+        double next = INITIAL_DESIGN[0];
+        while (procStatus && windows < MAX_WINDOWS)
+        {
+          device->setPowerLimitInMicroWatts(toMicroWatts(next));
+          auto result = measureTuningWindow(
+            reference,
+            tuningTimeWindowInMilliSeconds * 1000,
+            powerSamplingPeriodInMilliSeconds,
+            deviceState,
+            trigger,
+            procStatus,
+            childProcID,
+            logger);
+          logger.logPowerLogLine(deviceState, result, reference);
+          const double cost = getCost(result, reference, metric);
+          if (std::isfinite(cost))
+          {
+            gp.addObservation(next, cost);
+          }
+          windows++;
+
+          if (windows < INITIAL_DESIGN_SIZE)
+          {
+            next = INITIAL_DESIGN[windows];
+            continue;
+          }
+          gp.fit();
+          const auto [bestX, bestMean, bestVariance] = findPosteriorMinimum(gp);
+          const auto [candidate, improvement] = findMaxExpectedImprovement(gp, bestMean);
+          logIterationBO(windows, toMicroWatts(bestX), bestMean, std::sqrt(bestVariance),
+                         toMicroWatts(candidate), improvement);
+          if (improvement < MIN_EXPECTED_IMPROVEMENT && std::sqrt(bestVariance) < MAX_POSTERIOR_STD)
+          {
+            break;
+          }
+          next = candidate;
+          waitpid(childProcID, &procStatus, WNOHANG);
+        }
+        gp.fit();
+        return toMicroWatts(std::get<0>(findPosteriorMinimum(gp)));
+    }
+
+    static constexpr int GRID_SIZE {41};
+    static constexpr int MAX_WINDOWS {12};
+    static constexpr int INITIAL_DESIGN_SIZE {2};
+    static constexpr double INITIAL_DESIGN[INITIAL_DESIGN_SIZE] {0.2, 0.6};
+    // both in units of the relative cost, i.e., 0.005 stands for 0.5% of the reference
+    static constexpr double MIN_EXPECTED_IMPROVEMENT {0.002};
+    static constexpr double MAX_POSTERIOR_STD {0.01};
+
+    /*
+      findPosteriorMinimum - normalized cap, mean and variance of the lowest posterior mean,
+      the grid is scanned from the max cap so that a flat posterior keeps the default cap
+    */
+    static std::tuple<double, double, double> findPosteriorMinimum(const GaussianProcess& gp)
+    {
+        double bestX = 1.0, bestMean = INFINITY, bestVariance = 0.0;
+        for (int i = GRID_SIZE - 1; i >= 0; i--)
+        {
+            const auto [mean, variance] = gp.predict(gridPoint(i));
+            if (mean < bestMean)
+            {
+                bestX = gridPoint(i);
+                bestMean = mean;
+                bestVariance = variance;
+            }
+        }
+        return {bestX, bestMean, bestVariance};
+    }
+
+  private:
+    static double gridPoint(int i) { return double(i) / (GRID_SIZE - 1); }
+
+    std::pair<double, double> findMaxExpectedImprovement(const GaussianProcess& gp, double bestMean) const
+    {
+        double bestX = 1.0, bestImprovement = -1.0;
+        for (int i = 0; i < GRID_SIZE; i++)
+        {
+            const auto [mean, variance] = gp.predict(gridPoint(i));
+            const double sigma = std::sqrt(variance);
+            const double z = (bestMean - mean) / sigma;
+            const double improvement = (bestMean - mean) * 0.5 * std::erfc(-z / M_SQRT2) +
+                                       sigma * std::exp(-0.5 * z * z) / std::sqrt(2 * M_PI);
+            if (improvement > bestImprovement)
+            {
+                bestX = gridPoint(i);
+                bestImprovement = improvement;
+            }
+        }
+        return {bestX, bestImprovement};
+    }
+
+    void logIterationBO(int windows, int bestInMicroWatts, double bestMean, double bestStd,
+                        int nextInMicroWatts, double improvement) const
+    {
+        std::cout << "#--------------------------------\n"
+                  << "# BO after " << windows << " windows: best "
+                  << bestInMicroWatts / 1000 << " mW, cost "
+                  << std::fixed << std::setprecision(4) << bestMean << " +/- " << bestStd
+                  << ", next " << nextInMicroWatts / 1000 << " mW, EI " << improvement << "\n"
+                  << "#--------------------------------\n";
+    }
+};
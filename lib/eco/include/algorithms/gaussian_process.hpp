@@ -0,0 +1,205 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+/*
+  GaussianProcess - 1D Gaussian process regression with squared exponential kernel
+
+  Observed values are standardized before fitting, so the signal variance is 1 and the
+  noise variance is expressed relative to the variance of the observations. When enough
+  observations are available, the length scale and the noise variance are chosen from a
+  small grid by maximizing the marginal likelihood.
+*/
+class GaussianProcess
+{
+public:
+    GaussianProcess(double lengthScale = 0.3, double noiseVariance = 0.05) :
+        lengthScale_(lengthScale), noiseVariance_(noiseVariance)
+    {
+    }
+
+    void addObservation(double x, double y)
+    {
+        xs_.push_back(x);
+        ys_.push_back(y);
+        fitted_ = false;
+    }
+
+    std::size_t size() const { return xs_.size(); }
+    const std::vector<double>& getObservedX() const { return xs_; }
+
+    /*
+      fit - selects hyperparameters (if there are at least minObservationsForSelection_
+      observations) and factorizes the covariance matrix
+    */
+    void fit()
+    {
+        standardize();
+        if (xs_.size() >= minObservationsForSelection_)
+        {
+            double bestLikelihood = -INFINITY;
+            double bestLength = lengthScale_;
+            double bestNoise = noiseVariance_;
+            for (double length : {0.05, 0.1, 0.2, 0.3, 0.5, 1.0})
+            {
+                for (double noise : {0.001, 0.01, 0.05, 0.1, 0.3})
+                {
+                    double likelihood;
+                    if (factorize(length, noise, &likelihood) && likelihood > bestLikelihood)
+                    {
+                        bestLikelihood = likelihood;
+                        bestLength = length;
+                        bestNoise = noise;
+                    }
+                }
+            }
+            lengthScale_ = bestLength;
+            noiseVariance_ = bestNoise;
+        }
+        fitted_ = factorize(lengthScale_, noiseVariance_, nullptr);
+    }
+
+    /*
+      predict - posterior mean and variance of the latent function at x
+    */
+    std::pair<double, double> predict(double x) const
+    {
+        if (!fitted_)
+        {
+            return {yMean_, yScale_ * yScale_};
+        }
+        const auto n = xs_.size();
+        std::vector<double> k(n);
+        double mean = 0.0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            k[i] = kernel(x, xs_[i], lengthScale_);
+            mean += k[i] * alpha_[i];
+        }
+        // v = L^-1 k
+        for (std::size_t i = 0; i < n; i++)
+        {
+            for (std::size_t j = 0; j < i; j++)
+            {
+                k[i] -= chol_[i * n + j] * k[j];
+            }
+            k[i] /= chol_[i * n + i];
+        }
+        double variance = 1.0;
+        for (auto&& v : k)
+        {
+            variance -= v * v;
+        }
+        variance = std::max(variance, 1e-12);
+        return {yMean_ + yScale_ * mean, yScale_ * yScale_ * variance};
+    }
+
+    double getLengthScale() const { return lengthScale_; }
+    // noise variance in units of the observed values
+    double getNoiseVariance() const { return noiseVariance_ * yScale_ * yScale_; }
+
+private:
+    static double kernel(double a, double b, double lengthScale)
+    {
+        const double d = (a - b) / lengthScale;
+        return std::exp(-0.5 * d * d);
+    }
+
+    void standardize()
+    {
+        const auto n = ys_.size();
+        yMean_ = 0.0;
+        for (auto&& y : ys_) yMean_ += y;
+        yMean_ /= n;
+        double variance = 0.0;
+        for (auto&& y : ys_) variance += (y - yMean_) * (y - yMean_);
+        yScale_ = n > 1 ? std::sqrt(variance / (n - 1)) : 1.0;
+        if (yScale_ < 1e-9)
+        {
+            yScale_ = 1.0;
+        }
+        z_.resize(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            z_[i] = (ys_[i] - yMean_) / yScale_;
+        }
+    }
+
+    // Cholesky factorization of K + noise*I and alpha = (K + noise*I)^-1 z
+    bool factorize(double lengthScale, double noise, double* logLikelihood)
+    {
+        const auto n = xs_.size();
+        chol_.assign(n * n, 0.0);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            for (std::size_t j = 0; j <= i; j++)
+            {
+                double sum = kernel(xs_[i], xs_[j], lengthScale) + (i == j ? noise : 0.0);
+                for (std::size_t k = 0; k < j; k++)
+                {
+                    sum -= chol_[i * n + k] * chol_[j * n + k];
+                }
+                if (i == j)
+                {
+                    if (sum <= 0.0) return false;
+                    chol_[i * n + i] = std::sqrt(sum);
+                }
+                else
+                {
+                    chol_[i * n + j] = sum / chol_[j * n + j];
+                }
+            }
+        }
+        alpha_ = z_;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            for (std::size_t k = 0; k < i; k++) alpha_[i] -= chol_[i * n + k] * alpha_[k];
+            alpha_[i] /= chol_[i * n + i];
+        }
+        double fitTerm = 0.0;
+        for (auto&& a : alpha_) fitTerm += a * a;
+        for (std::size_t i = n; i-- > 0;)
+        {
+            for (std::size_t k = i + 1; k < n; k++) alpha_[i] -= chol_[k * n + i] * alpha_[k];
+            alpha_[i] /= chol_[i * n + i];
+        }
+        if (logLikelihood)
+        {
+            double logDet = 0.0;
+            for (std::size_t i = 0; i < n; i++) logDet += std::log(chol_[i * n + i]);
+            *logLikelihood = -0.5 * fitTerm - logDet - 0.5 * n * std::log(2 * M_PI);
+        }
+        return true;
+    }
+
+    double lengthScale_;
+    double noiseVariance_;
+    static constexpr std::size_t minObservationsForSelection_ {4};
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<double> z_;
+    std::vector<double> chol_;
+    std::vector<double> alpha_;
+    double yMean_ {0.0};
+    double yScale_ {1.0};
+    bool fitted_ {false};
+};
@@ -54,8 +54,13 @@ class GoldenSectionSearchAlgorithm : public SearchAlgorithm
           auto fL = tmp;
           if (measureL)
           {
+            // the incumbent is the right candidate retained from the previous step,
+            // or the reference in the first one
             device->setPowerLimitInMicroWatts(leftCandidateInMicroiWatts);
-            fL = sampleAndAccumulatePowAndPerfForGivenPeriod(
+            fL = measureTuningWindowAgainstIncumbent(
+              reference,
+              tmp,
+              metric,
               tuningTimeWindowInMilliSeconds * 1000,
               powerSamplingPeriodInMilliSeconds,
               deviceState,
@@ -69,7 +74,11 @@ class GoldenSectionSearchAlgorithm : public SearchAlgorithm
           if (measureR)
           {
             device->setPowerLimitInMicroWatts(rightCandidateInMicroWatts);
-            fR = sampleAndAccumulatePowAndPerfForGivenPeriod(
+            // the left candidate is either just measured or retained from the previous step
+            fR = measureTuningWindowAgainstIncumbent(
+              reference,
+              fL,
+              metric,
               tuningTimeWindowInMilliSeconds * 1000,
               powerSamplingPeriodInMilliSeconds,
               deviceState,
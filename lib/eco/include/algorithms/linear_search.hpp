@@ -45,7 +45,10 @@ class LinearSearchAlgorithm : public SearchAlgorithm
       while(procStatus)
       {
         device->setPowerLimitInMicroWatts(currentLimitInMicroWatts);
-        auto&& currentResult = sampleAndAccumulatePowAndPerfForGivenPeriod(
+        auto&& currentResult = measureTuningWindowAgainstIncumbent(
+          reference,
+          bestResultSoFar,
+          metric,
           tuningTimeWindowInMilliSeconds * 1e3,
           powerSamplingPeriodInMilliSeconds,
           deviceState,
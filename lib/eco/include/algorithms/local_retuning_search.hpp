@@ -0,0 +1,175 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "algorithms/abstract_search_algorithm.hpp"
+#include "data_structures/measurement_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <utility>
+
+
+/*
+  LocalRetuningSearchAlgorithm - re-tuning around the optimum found by the previous
+  tuning phase instead of searching the whole range again
+
+  The previous optimum and its neighbours at INITIAL_RADIUS of the range are measured.
+  If the previous optimum is still the best, the search ends after three windows.
+  Otherwise the optimum has moved: the step doubles in the improving direction as long
+  as the cost improves, then it is halved back to INITIAL_RADIUS while probing around the
+  new optimum. Caps are snapped to 1/GRID_STEPS of the range so that the same caps are
+  measured across tuning phases. The comparisons use only the windows of this tuning
+  phase. The older windows from the age-decayed cache, evaluated against the current
+  reference, decide which neighbour is probed first: if it improves on the previous
+  optimum, the other one is not measured.
+*/
+class LocalRetuningSearchAlgorithm : public SearchAlgorithm
+{
+  public:
+    LocalRetuningSearchAlgorithm(int previousCapInMicroWatts, std::shared_ptr<MeasurementCache> cache) :
+      previousCapInMicroWatts_(previousCapInMicroWatts), cache_(std::move(cache))
+    {
+    }
+
+    unsigned operator() (
+      std::shared_ptr<Device> device,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      TargetMetric metric,
+      const PowAndPerfResult& reference,
+      int& procStatus,
+      int childProcID,
+      int powerSamplingPeriodInMilliSeconds,
+      int tuningTimeWindowInMilliSeconds,
+      Logger& logger) const
+    {
+        const auto [minLimitInWatts, maxLimitInWatts] = device->getMinMaxLimitInWatts();
+        const double minInMicroWatts = minLimitInWatts * 1e6;
+        const double maxInMicroWatts = maxLimitInWatts * 1e6;
+        const double gridInMicroWatts = (maxInMicroWatts - minInMicroWatts) / GRID_STEPS;
+        auto snap = [&](double capInMicroWatts) {
+            const double clamped = std::clamp(capInMicroWatts, minInMicroWatts, maxInMicroWatts);
+            return static_cast<int>(minInMicroWatts + std::round((clamped - minInMicroWatts) / gridInMicroWatts) * gridInMicroWatts);
+        };
+
+        cache_->evictStale();
+        std::map<int, double> costs;
+        int windows = 0;
+        // cost of the window of this tuning phase, each cap is measured at most once
+        auto evaluate = [&](int capInMicroWatts) -> double {
+            auto it = costs.find(capInMicroWatts);
+            if (it != costs.end())
+            {
+                return it->second;
+            }
+            if (!procStatus || windows >= MAX_WINDOWS)
+            {
+                return INFINITY;
+            }
+            device->setPowerLimitInMicroWatts(capInMicroWatts);
+            auto result = measureTuningWindow(
+              reference,
+              tuningTimeWindowInMilliSeconds * 1000,
+              powerSamplingPeriodInMilliSeconds,
+              deviceState,
+              trigger,
+              procStatus,
+              childProcID,
+              logger);
+            logger.logPowerLogLine(deviceState, result, reference);
+            cache_->add(capInMicroWatts, result);
+            windows++;
+            const double cost = getCost(result, reference, metric);
+            return costs[capInMicroWatts] = std::isfinite(cost) ? cost : INFINITY;
+        };
+        // cost of the older windows against the current reference, only orders the probes
+        auto getHistoricalCost = [&](int capInMicroWatts) {
+            const auto estimate = cache_->getEstimate(capInMicroWatts);
+            const double cost = estimate ? getCost(*estimate, reference, metric) : INFINITY;
+            return std::isfinite(cost) ? cost : INFINITY;
+        };
+        auto orderByHistory = [&](int first, int second) {
+            return getHistoricalCost(second) < getHistoricalCost(first) ? std::make_pair(second, first) : std::make_pair(first, second);
+        };
+
+        double step = INITIAL_RADIUS * (maxInMicroWatts - minInMicroWatts);
+        int center = snap(previousCapInMicroWatts_);
+        double centerCost = evaluate(center);
+        int moved = center;
+        double movedCost = INFINITY;
+        const auto [firstNeighbour, secondNeighbour] = orderByHistory(snap(center - step), snap(center + step));
+        for (auto neighbour : {firstNeighbour, secondNeighbour})
+        {
+            const double cost = neighbour != center ? evaluate(neighbour) : INFINITY;
+            if (cost < centerCost)
+            {
+                moved = neighbour;
+                movedCost = cost;
+                break;
+            }
+        }
+        if (moved == center)
+        {
+            return center;
+        }
+
+        // the optimum has moved, widen in the improving direction
+        const int direction = moved < center ? -1 : 1;
+        center = moved;
+        centerCost = movedCost;
+        while (procStatus && windows < MAX_WINDOWS)
+        {
+            step *= 2.0;
+            const int next = snap(center + direction * step);
+            const double nextCost = next != center ? evaluate(next) : INFINITY;
+            if (!(nextCost < centerCost))
+            {
+                break;
+            }
+            center = next;
+            centerCost = nextCost;
+        }
+        // narrow down around the new optimum
+        while (procStatus && windows < MAX_WINDOWS && step > INITIAL_RADIUS * (maxInMicroWatts - minInMicroWatts))
+        {
+            step /= 2.0;
+            const auto [first, second] = orderByHistory(snap(center - step), snap(center + step));
+            for (auto candidate : {first, second})
+            {
+                const double cost = candidate != center ? evaluate(candidate) : INFINITY;
+                if (cost < centerCost)
+                {
+                    center = candidate;
+                    centerCost = cost;
+                    break;
+                }
+            }
+        }
+        return center;
+    }
+
+  private:
+    static constexpr double INITIAL_RADIUS {0.05};
+    static constexpr double GRID_STEPS {100.0};
+    static constexpr int MAX_WINDOWS {10};
+
+    int previousCapInMicroWatts_;
+    std::shared_ptr<MeasurementCache> cache_;
+};
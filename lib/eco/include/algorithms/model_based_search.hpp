@@ -0,0 +1,154 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "algorithms/abstract_search_algorithm.hpp"
+#include "algorithms/saturating_performance_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+/*
+  ModelBasedSearchAlgorithm - power cap predicted by a model fitted from a few probes
+
+  The caps at PROBE_FRACTIONS of the range are measured and, together with the reference
+  run, used to fit SaturatingPerformanceModel. The optimal power of the metric is
+  translated to the cap with the linear fit of the measured power over the caps that
+  were actually limiting the power (the power equals the cap if less than two of them).
+  The predicted cap is measured in one more window and returned if it beats all probes,
+  otherwise the best probe is returned.
+*/
+class ModelBasedSearchAlgorithm : public SearchAlgorithm
+{
+  public:
+    unsigned operator() (
+      std::shared_ptr<Device> device,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      TargetMetric metric,
+      const PowAndPerfResult& reference,
+      int& procStatus,
+      int childProcID,
+      int powerSamplingPeriodInMilliSeconds,
+      int tuningTimeWindowInMilliSeconds,
+      Logger& logger) const
+    {
+        const auto [minLimitInWatts, maxLimitInWatts] = device->getMinMaxLimitInWatts();
+        const double minInMicroWatts = minLimitInWatts * 1e6;
+        const double maxInMicroWatts = maxLimitInWatts * 1e6;
+
+        struct Probe
+        {
+            int capInMicroWatts_;
+            PowAndPerfResult result_;
+        };
+        std::vector<Probe> probes {{static_cast<int>(maxInMicroWatts), reference}};
+        auto measure = [&](int capInMicroWatts) {
+            device->setPowerLimitInMicroWatts(capInMicroWatts);
+            auto result = measureTuningWindow(
+              reference,
+              tuningTimeWindowInMilliSeconds * 1000,
+              powerSamplingPeriodInMilliSeconds,
+              deviceState,
+              trigger,
+              procStatus,
+              childProcID,
+              logger);
+            logger.logPowerLogLine(deviceState, result, reference);
+            probes.push_back({capInMicroWatts, result});
+        };
+        for (auto&& fraction : PROBE_FRACTIONS)
+        {
+            if (!procStatus) break;
+            measure(minInMicroWatts + fraction * (maxInMicroWatts - minInMicroWatts));
+        }
+
+        auto best = std::min_element(probes.begin(), probes.end(), [&](const Probe& l, const Probe& r) {
+            return getCost(l.result_, reference, metric) < getCost(r.result_, reference, metric);
+        });
+        int bestCapInMicroWatts = best->capInMicroWatts_;
+        const double bestCost = getCost(best->result_, reference, metric);
+
+        std::vector<SaturatingPerformanceModel::Point> points;
+        for (auto&& probe : probes)
+        {
+            points.push_back({probe.result_.averageCorePowerInWatts_, probe.result_.getInstrPerSecond()});
+        }
+        auto model = SaturatingPerformanceModel::fit(points, device->getIdlePowerInWatts());
+        if (!model || !procStatus)
+        {
+            std::cout << "[INFO] Power-performance model not fitted, using the best probe.\n";
+            return bestCapInMicroWatts;
+        }
+        const double optimalPowerInWatts = model->getOptimalPowerInWatts(metric, reference.averageCorePowerInWatts_, plusMetricK_);
+        const double predictedCapInWatts = getCapForPower(probes, reference, optimalPowerInWatts);
+        if (std::isnan(predictedCapInWatts))
+        {
+            std::cout << "[INFO] Power-performance model gave no optimum, using the best probe.\n";
+            return bestCapInMicroWatts;
+        }
+        // an infinite optimum is clamped to the highest cap before the conversion
+        const int predictedCapInMicroWatts = std::clamp(predictedCapInWatts * 1e6, minInMicroWatts, maxInMicroWatts);
+        std::cout << "[INFO] Power-performance model: idle " << model->getIdlePowerInWatts()
+                  << "W, half saturation " << model->getHalfSaturationInWatts()
+                  << "W, predicted cap " << predictedCapInMicroWatts / 1e6 << "W.\n";
+
+        if (std::none_of(probes.begin(), probes.end(), [&](const Probe& p) { return p.capInMicroWatts_ == predictedCapInMicroWatts; }))
+        {
+            measure(predictedCapInMicroWatts);
+            if (getCost(probes.back().result_, reference, metric) < bestCost)
+            {
+                bestCapInMicroWatts = predictedCapInMicroWatts;
+            }
+        }
+        return bestCapInMicroWatts;
+    }
+
+  private:
+    template <class Probes>
+    static double getCapForPower(const Probes& probes, const PowAndPerfResult& reference, double powerInWatts)
+    {
+        // only the caps limiting the power tell how the power follows the cap
+        double n = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+        for (auto&& probe : probes)
+        {
+            const double power = probe.result_.averageCorePowerInWatts_;
+            if (power < LIMITING_FRACTION * reference.averageCorePowerInWatts_)
+            {
+                const double cap = probe.capInMicroWatts_ / 1e6;
+                n += 1.0;
+                sx += cap;
+                sy += power;
+                sxx += cap * cap;
+                sxy += cap * power;
+            }
+        }
+        const double denominator = n * sxx - sx * sx;
+        if (n < 2.0 || denominator <= 0.0)
+        {
+            return powerInWatts;
+        }
+        const double slope = (n * sxy - sx * sy) / denominator;
+        const double intercept = (sy - slope * sx) / n;
+        return slope > 0.0 ? (powerInWatts - intercept) / slope : powerInWatts;
+    }
+
+    static constexpr double PROBE_FRACTIONS[] {0.3, 0.55, 0.8};
+    static constexpr double LIMITING_FRACTION {0.97};
+};
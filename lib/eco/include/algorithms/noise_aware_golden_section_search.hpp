@@ -0,0 +1,184 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "algorithms/abstract_search_algorithm.hpp"
+#include "data_structures/streaming_statistics.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <map>
+
+
+/*
+  NoiseAwareGoldenSectionSearchAlgorithm - GSS comparing candidates by confidence intervals
+
+  Each tuning window yields the per-sample relative cost of the target metric, so
+  every measured cap has a mean cost with its standard error. When the confidence
+  intervals of the left and right candidates overlap, the less certain one is
+  re-measured (up to MAX_REPEATS extra windows per comparison) before the bracket is
+  narrowed. Measurements of a cap are kept and reused whenever the cap is evaluated
+  again. Caps without finite per-sample costs are compared by their whole window cost.
+  The midpoint of the final bracket is measured as well and compared against
+  the best measured cap, the better of the two is returned.
+*/
+class NoiseAwareGoldenSectionSearchAlgorithm : public SearchAlgorithm
+{
+  public:
+    unsigned operator() (
+      std::shared_ptr<Device> device,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      TargetMetric metric,
+      const PowAndPerfResult& reference,
+      int& procStatus,
+      int childProcID,
+      int powerSamplingPeriodInMilliSeconds,
+      int tuningTimeWindowInMilliSeconds,
+      Logger& logger) const
+    {
+        const auto [minLimitInWatts, maxLimitInWatts] = device->getMinMaxLimitInWatts();
+        int EPSILON = (maxLimitInWatts - minLimitInWatts) * 1e6 / 25;
+
+        int a = minLimitInWatts * 1e6; // micro watts
+        int b = maxLimitInWatts * 1e6; // micro watts
+
+        int leftCandidateInMicroWatts = b - int(PHI * (b - a));
+        int rightCandidateInMicroWatts = a + int(PHI * (b - a));
+
+        std::map<int, StreamingStatistics> costs;
+        // whole window costs, the fallback for caps without finite per-sample costs
+        // (e.g., no instructions or kernels counted within any of the samples)
+        std::map<int, StreamingStatistics> windowCosts;
+        std::map<int, int> windows;
+        auto measure = [&](int capInMicroWatts) {
+            device->setPowerLimitInMicroWatts(capInMicroWatts);
+            auto& stats = costs[capInMicroWatts];
+            auto result = measureTuningWindow(
+              reference,
+              tuningTimeWindowInMilliSeconds * 1000,
+              powerSamplingPeriodInMilliSeconds,
+              deviceState,
+              trigger,
+              procStatus,
+              childProcID,
+              logger,
+              [&](PowAndPerfResult& sample) {
+                  sample.checkPlusMetric(reference, plusMetricK_);
+                  const double cost = sample.getRelativeCost(reference, metric);
+                  if (std::isfinite(cost)) stats.add(cost);
+              });
+            logger.logPowerLogLine(deviceState, result, reference);
+            windows[capInMicroWatts]++;
+            const double cost = getCost(result, reference, metric);
+            if (std::isfinite(cost)) windowCosts[capInMicroWatts].add(cost);
+        };
+        auto getMeanCost = [&](int capInMicroWatts) {
+            if (costs[capInMicroWatts].getCount())
+            {
+                return costs[capInMicroWatts].getMean();
+            }
+            const auto& window = windowCosts[capInMicroWatts];
+            return window.getCount() ? window.getMean() : INFINITY;
+        };
+        // measures until the confidence intervals do not overlap or the repeats are exhausted,
+        // returns true when the right candidate has lower mean cost
+        auto isRightBetter = [&](int left, int right) {
+            int repeats = 0;
+            while (procStatus)
+            {
+                if (!windows[left]) { measure(left); continue; }
+                if (!windows[right]) { measure(right); continue; }
+                const auto& l = costs[left];
+                const auto& r = costs[right];
+                if (repeats >= MAX_REPEATS || (l.getCount() && r.getCount() && !doIntervalsOverlap(l, r)))
+                {
+                    break;
+                }
+                // caps without per-sample costs are re-measured first, within the same repeats limit
+                measure(!l.getCount() ? left : !r.getCount() ? right : l.getStdError() > r.getStdError() ? left : right);
+                repeats++;
+            }
+            return getMeanCost(right) < getMeanCost(left);
+        };
+
+        while ((b - a) > EPSILON && procStatus)
+        {
+          logCurrentRangeNGSS(a, leftCandidateInMicroWatts/1000, rightCandidateInMicroWatts/1000, b);
+          if (!isRightBetter(leftCandidateInMicroWatts, rightCandidateInMicroWatts)) {
+            // choose subrange [a, rightCandidate]
+            b = rightCandidateInMicroWatts;
+            rightCandidateInMicroWatts = leftCandidateInMicroWatts;
+            leftCandidateInMicroWatts = b - int(PHI * (b - a));
+          } else {
+            // choose subrange [leftCandidate, b]
+            a = leftCandidateInMicroWatts;
+            leftCandidateInMicroWatts = rightCandidateInMicroWatts;
+            rightCandidateInMicroWatts = a + int(PHI * (b - a));
+          }
+          waitpid(childProcID, &procStatus, WNOHANG);
+        }
+
+        // the midpoint is returned only if it is verified not to be worse than the best measured cap
+        const int midpoint = (a + b) / 2;
+        int bestMeasured = -1;
+        for (auto&& [cap, count] : windows)
+        {
+            if (std::isfinite(getMeanCost(cap)) && (bestMeasured < 0 || getMeanCost(cap) < getMeanCost(bestMeasured)))
+            {
+                bestMeasured = cap;
+            }
+        }
+        if (bestMeasured < 0)
+        {
+            return midpoint;
+        }
+        if (!procStatus || midpoint == bestMeasured)
+        {
+            return bestMeasured;
+        }
+        const int result = isRightBetter(bestMeasured, midpoint) ? midpoint : bestMeasured;
+        const auto flags = std::cout.flags();
+        const auto precision = std::cout.precision();
+        std::cout << "# NGSS verified bracket midpoint " << midpoint / 1000 << " mW (cost "
+                  << std::fixed << std::setprecision(4) << getMeanCost(midpoint)
+                  << ") against best measured " << bestMeasured / 1000 << " mW (cost "
+                  << getMeanCost(bestMeasured) << "), selected " << result / 1000 << " mW\n";
+        std::cout.flags(flags);
+        std::cout.precision(precision);
+        return result;
+    }
+    static constexpr float PHI {(sqrt(5) - 1) / 2};
+    static constexpr int MAX_REPEATS {2};
+    static constexpr double Z_SCORE {1.96}; // 95% confidence
+  private:
+    static bool doIntervalsOverlap(const StreamingStatistics& l, const StreamingStatistics& r)
+    {
+        return std::abs(l.getMean() - r.getMean()) < Z_SCORE * std::hypot(l.getStdError(), r.getStdError());
+    }
+
+    void logCurrentRangeNGSS(int a, int leftCandidateInMilliWatts, int rightCandidateInMilliWatts, int b) const
+    {
+        std::cout << "#--------------------------------\n"
+                  << "# Current NGSS range: |"
+                  << a << " "
+                  << leftCandidateInMilliWatts << " "
+                  << rightCandidateInMilliWatts << " "
+                  << b << "|\n"
+                  << "#--------------------------------\n";
+    }
+};
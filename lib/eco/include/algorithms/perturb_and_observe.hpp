@@ -0,0 +1,91 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+
+/*
+  PerturbAndObserveController - hill climbing of the power cap during the execution
+
+  Each update() gets the relative cost of the window measured with the current cap
+  (lower is better) and returns the cap for the next window. The cap moves in the
+  current direction as long as the cost improves, growing the step, and reverses with
+  a halved step otherwise. Steps are kept within [MIN_STEP, MAX_STEP] of the caps range,
+  so around the optimum the cap keeps dithering by the min step and follows the
+  optimum when the application behaviour drifts.
+*/
+class PerturbAndObserveController
+{
+  public:
+    PerturbAndObserveController(double minCapInWatts, double maxCapInWatts, double initialCapInWatts) :
+        minCap_(minCapInWatts),
+        maxCap_(maxCapInWatts),
+        cap_(std::clamp(initialCapInWatts, minCapInWatts, maxCapInWatts)),
+        step_(INITIAL_STEP * (maxCapInWatts - minCapInWatts))
+    {
+    }
+
+    double update(double cost)
+    {
+        const double range = maxCap_ - minCap_;
+        if (std::isfinite(previousCost_))
+        {
+            if (cost < previousCost_)
+            {
+                step_ = std::min(step_ * STEP_GROWTH, MAX_STEP * range);
+            }
+            else
+            {
+                direction_ = -direction_;
+                step_ = std::max(step_ * STEP_SHRINK, MIN_STEP * range);
+            }
+        }
+        if (std::isfinite(cost))
+        {
+            previousCost_ = cost;
+        }
+        double next = cap_ + direction_ * step_;
+        if (next < minCap_ || next > maxCap_)
+        {
+            // bounce back from the boundary of the range
+            direction_ = -direction_;
+            next = std::clamp(next, minCap_, maxCap_);
+        }
+        cap_ = next;
+        return cap_;
+    }
+
+    double getCapInWatts() const { return cap_; }
+    double getStepInWatts() const { return step_; }
+
+    // fractions of the caps range
+    static constexpr double INITIAL_STEP {0.05};
+    static constexpr double MIN_STEP {0.01};
+    static constexpr double MAX_STEP {0.1};
+    static constexpr double STEP_GROWTH {1.5};
+    static constexpr double STEP_SHRINK {0.5};
+
+  private:
+    double minCap_;
+    double maxCap_;
+    double cap_;
+    double step_;
+    double direction_ {-1.0}; // lowering the cap first as the default is the max one
+    double previousCost_ {INFINITY};
+};
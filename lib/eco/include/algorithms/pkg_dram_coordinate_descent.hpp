@@ -0,0 +1,156 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "algorithms/abstract_search_algorithm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+
+
+/*
+  PkgDramCoordinateDescentAlgorithm - joint search of PKG and DRAM power limits
+
+  Compass search over the two limits with the objective computed for the combined
+  PKG+DRAM energy (see PowAndPerfResult::withMemoryEnergy). Starting from the default
+  limits (the reference run), each coordinate is decreased and then increased by the
+  current step, moving whenever the cost improves. When neither coordinate improves,
+  the steps are halved until they fall below 1/25 of the ranges (like GSS precision).
+  Devices without a cappable DRAM domain are searched along PKG only.
+  The best DRAM limit stays applied, the best PKG limit is returned.
+*/
+class PkgDramCoordinateDescentAlgorithm : public SearchAlgorithm
+{
+  public:
+    unsigned operator() (
+      std::shared_ptr<Device> device,
+      DeviceStateAccumulator& deviceState,
+      Trigger& trigger,
+      TargetMetric metric,
+      const PowAndPerfResult& reference,
+      int& procStatus,
+      int childProcID,
+      int powerSamplingPeriodInMilliSeconds,
+      int tuningTimeWindowInMilliSeconds,
+      Logger& logger) const
+    {
+        static constexpr std::array<Domain, 2> domains {Domain::PKG, Domain::DRAM};
+        std::array<double, 2> minLimit, maxLimit, step, best;
+        std::size_t dimensions = 0;
+        for (auto&& d : domains)
+        {
+            const auto [minInWatts, maxInWatts] = device->getDomainMinMaxLimitInWatts(d);
+            if (maxInWatts == 0)
+            {
+                break;
+            }
+            minLimit[dimensions] = minInWatts * 1e6; // micro watts
+            maxLimit[dimensions] = maxInWatts * 1e6;
+            step[dimensions] = INITIAL_STEP * (maxLimit[dimensions] - minLimit[dimensions]);
+            best[dimensions] = maxLimit[dimensions];
+            dimensions++;
+        }
+        if (dimensions < 2)
+        {
+            std::cout << "[INFO] DRAM power limit not available, searching PKG limit only.\n";
+        }
+        auto toLimits = [&](const std::array<double, 2>& point) {
+            PowerLimits limits;
+            for (std::size_t i = 0; i < dimensions; i++)
+            {
+                limits[domains[i]] = (unsigned long)point[i];
+            }
+            return limits;
+        };
+
+        const auto combinedReference = reference.withMemoryEnergy();
+        double bestCost = 1.0; // reference is measured with the default, i.e., the max limits
+        auto evaluate = [&](const std::array<double, 2>& point) {
+            device->setPowerLimitsInMicroWatts(toLimits(point));
+            auto result = measureTuningWindow(
+              reference,
+              tuningTimeWindowInMilliSeconds * 1000,
+              powerSamplingPeriodInMilliSeconds,
+              deviceState,
+              trigger,
+              procStatus,
+              childProcID,
+              logger);
+            logger.logPowerLogLine(deviceState, result, reference);
+            auto combined = result.withMemoryEnergy();
+            combined.checkPlusMetric(combinedReference, plusMetricK_);
+            const double cost = combined.getRelativeCost(combinedReference, metric);
+            logPoint(point, dimensions, cost);
+            return std::isfinite(cost) ? cost : INFINITY;
+        };
+
+        auto isConverged = [&] {
+            for (std::size_t i = 0; i < dimensions; i++)
+            {
+                if (step[i] >= (maxLimit[i] - minLimit[i]) / PRECISION_DIVISOR) return false;
+            }
+            return true;
+        };
+
+        while (procStatus && !isConverged())
+        {
+          bool improved = false;
+          for (std::size_t i = 0; i < dimensions && procStatus; i++)
+          {
+            for (double direction : {-1.0, 1.0})
+            {
+              auto candidate = best;
+              candidate[i] = std::clamp(best[i] + direction * step[i], minLimit[i], maxLimit[i]);
+              if (candidate[i] == best[i])
+              {
+                continue;
+              }
+              const double cost = evaluate(candidate);
+              if (cost < bestCost)
+              {
+                best = candidate;
+                bestCost = cost;
+                improved = true;
+                break;
+              }
+              if (!procStatus) break;
+            }
+          }
+          if (!improved)
+          {
+            for (std::size_t i = 0; i < dimensions; i++) step[i] /= 2;
+          }
+          waitpid(childProcID, &procStatus, WNOHANG);
+        }
+        device->setPowerLimitsInMicroWatts(toLimits(best));
+        return (unsigned)best[0];
+    }
+    static constexpr double INITIAL_STEP {0.25}; // fraction of the limits range
+    static constexpr double PRECISION_DIVISOR {25.0};
+  private:
+    void logPoint(const std::array<double, 2>& point, std::size_t dimensions, double cost) const
+    {
+        std::cout << "# PKG+DRAM search: PKG " << point[0] / 1000 << " mW";
+        if (dimensions > 1)
+        {
+            std::cout << ", DRAM " << point[1] / 1000 << " mW";
+        }
+        std::cout << ", relative cost " << std::fixed << std::setprecision(4) << cost << "\n";
+    }
+};
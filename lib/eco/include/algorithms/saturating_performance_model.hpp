@@ -0,0 +1,177 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "eco_constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+/*
+  SaturatingPerformanceModel - performance saturating with power above the idle floor
+
+    IPS(W) = maxIps * x / (halfSaturation + x),  x = W - idlePower
+
+  i.e., Michaelis-Menten like curve: linear for low power and flat once the power
+  is no longer the bottleneck (e.g., memory or communication bound phases).
+  maxIps and halfSaturation are fitted with weighted least squares of 1/IPS over 1/x,
+  the idle power is taken from the device or, if unknown, chosen on a grid to minimize
+  the squared error of IPS. The optimal power of MIN_E, MIN_E_X_T and MIN_M_PLUS
+  follows in closed form.
+*/
+class SaturatingPerformanceModel
+{
+  public:
+    struct Point
+    {
+        double powerInWatts_;
+        double instructionsPerSecond_;
+    };
+
+    /*
+      fit - returns std::nullopt if the points do not follow a saturating curve
+    */
+    static std::optional<SaturatingPerformanceModel> fit(const std::vector<Point>& points, double idlePowerInWatts)
+    {
+        if (points.size() < 3)
+        {
+            return std::nullopt;
+        }
+        if (idlePowerInWatts > 0.0)
+        {
+            return fitForIdlePower(points, idlePowerInWatts);
+        }
+        double minPower = INFINITY;
+        for (auto&& point : points) minPower = std::min(minPower, point.powerInWatts_);
+        std::optional<SaturatingPerformanceModel> best;
+        double bestError = INFINITY;
+        for (int i = 0; i < IDLE_GRID_STEPS; i++)
+        {
+            auto model = fitForIdlePower(points, MAX_IDLE_FRACTION * minPower * i / IDLE_GRID_STEPS);
+            if (!model) continue;
+            const double error = model->getSquaredError(points);
+            if (error < bestError)
+            {
+                bestError = error;
+                best = model;
+            }
+        }
+        return best;
+    }
+
+    double getInstructionsPerSecond(double powerInWatts) const
+    {
+        const double x = std::max(0.0, powerInWatts - idlePowerInWatts_);
+        return maxIps_ * x / (halfSaturationInWatts_ + x);
+    }
+
+    /*
+      getOptimalPowerInWatts - power minimizing the metric, referencePower is the power
+      of the reference run needed by MIN_M_PLUS with the given k; INFINITY if the metric
+      keeps falling with the power (MIN_M_PLUS with k <= 1), i.e. the highest cap is optimal
+    */
+    double getOptimalPowerInWatts(TargetMetric metric, double referencePowerInWatts, double k) const
+    {
+        const double i = idlePowerInWatts_;
+        const double K = halfSaturationInWatts_;
+        double x = 0.0;
+        if (metric == TargetMetric::MIN_E)
+        {
+            // W / IPS ~ x + (i + K) + i * K / x
+            x = std::sqrt(i * K);
+        }
+        else if (metric == TargetMetric::MIN_E_X_T)
+        {
+            // W / IPS^2 ~ (x + i) * (K + x)^2 / x^2, zero derivative: x^2 - K * x - 2 * i * K = 0
+            x = 0.5 * (K + std::sqrt(K * K + 8.0 * i * K));
+        }
+        else
+        {
+            if (k <= 1.0)
+            {
+                return INFINITY;
+            }
+            // ((k - 1) * W / Wref + 1) / IPS, the same form as energy with a higher power floor
+            x = std::sqrt((i + referencePowerInWatts / (k - 1.0)) * K);
+        }
+        return std::isfinite(x) ? i + x : INFINITY;
+    }
+
+    double getIdlePowerInWatts() const { return idlePowerInWatts_; }
+    double getHalfSaturationInWatts() const { return halfSaturationInWatts_; }
+    double getMaxInstructionsPerSecond() const { return maxIps_; }
+
+  private:
+    SaturatingPerformanceModel(double idlePowerInWatts, double halfSaturationInWatts, double maxIps) :
+        idlePowerInWatts_(idlePowerInWatts), halfSaturationInWatts_(halfSaturationInWatts), maxIps_(maxIps)
+    {
+    }
+
+    static std::optional<SaturatingPerformanceModel> fitForIdlePower(const std::vector<Point>& points, double idlePowerInWatts)
+    {
+        // 1/IPS = 1/maxIps + (K/maxIps) * 1/x, weighted with IPS^2 as the relative noise is alike
+        double sw = 0.0, su = 0.0, sy = 0.0, suu = 0.0, suy = 0.0;
+        for (auto&& point : points)
+        {
+            const double x = point.powerInWatts_ - idlePowerInWatts;
+            if (x <= 0.0 || point.instructionsPerSecond_ <= 0.0)
+            {
+                return std::nullopt;
+            }
+            const double w = point.instructionsPerSecond_ * point.instructionsPerSecond_;
+            const double u = 1.0 / x;
+            const double y = 1.0 / point.instructionsPerSecond_;
+            sw += w;
+            su += w * u;
+            sy += w * y;
+            suu += w * u * u;
+            suy += w * u * y;
+        }
+        const double denominator = sw * suu - su * su;
+        if (denominator <= 0.0)
+        {
+            return std::nullopt;
+        }
+        const double slope = (sw * suy - su * sy) / denominator;
+        const double intercept = (sy - slope * su) / sw;
+        if (intercept <= 0.0 || slope <= 0.0)
+        {
+            return std::nullopt;
+        }
+        return SaturatingPerformanceModel(idlePowerInWatts, slope / intercept, 1.0 / intercept);
+    }
+
+    double getSquaredError(const std::vector<Point>& points) const
+    {
+        double error = 0.0;
+        for (auto&& point : points)
+        {
+            const double relative = getInstructionsPerSecond(point.powerInWatts_) / point.instructionsPerSecond_ - 1.0;
+            error += relative * relative;
+        }
+        return error;
+    }
+
+    static constexpr int IDLE_GRID_STEPS {50};
+    static constexpr double MAX_IDLE_FRACTION {0.95};
+
+    double idlePowerInWatts_;
+    double halfSaturationInWatts_;
+    double maxIps_;
+};
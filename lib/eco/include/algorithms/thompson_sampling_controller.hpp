@@ -0,0 +1,230 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+  ThompsonSamplingController - multi-armed bandit over the caps around the tuned one
+  during the execution phase
+
+  The arms are the exploitation cap and NEIGHBOURS caps on each side, ARM_SPACING of
+  the range apart. The relative costs of each arm are kept as statistics discounted
+  with the half-life of HALF_LIFE_IN_SECONDS of the execution time, so that the knowledge
+  of the arms not measured recently fades and the application drift is followed.
+  While the time of exploratory windows stays within explorationFraction of the total,
+  next() draws the mean cost of every arm from its normal posterior (the prior being
+  centred at the exploitation arm) and picks the lowest one. The exploitation cap moves
+  to a neighbour once its mean cost is lower with about 95% confidence, the arms are then
+  re-centred around it.
+  The windows differ in length (the exploratory ones are as short as the tuning window),
+  so every cost is weighted with its duration in nominal windows, the noise variance
+  being the one of a single nominal window.
+*/
+class ThompsonSamplingController
+{
+public:
+    struct Decision
+    {
+        double capInWatts_;
+        bool isExploration_;
+    };
+
+    ThompsonSamplingController(
+        double minCapInWatts,
+        double maxCapInWatts,
+        double initialCapInWatts,
+        double explorationFraction,
+        double nominalWindowInSeconds,
+        unsigned seed = std::random_device{}()) :
+        minCap_(minCapInWatts),
+        maxCap_(maxCapInWatts),
+        step_(ARM_SPACING * (maxCapInWatts - minCapInWatts)),
+        explorationFraction_(explorationFraction),
+        nominalWindowInSeconds_(nominalWindowInSeconds),
+        generator_(seed)
+    {
+        centerArmsAround(std::clamp(initialCapInWatts, minCapInWatts, maxCapInWatts));
+    }
+
+    Decision next()
+    {
+        const double exploitationCap = arms_[exploitation_].cap_;
+        if (explorationTime_ > explorationFraction_ * totalTime_)
+        {
+            return {exploitationCap, false};
+        }
+        const auto [priorMean, variance] = getPriorMeanAndNoiseVariance();
+        std::size_t chosen = exploitation_;
+        double lowest = INFINITY;
+        for (std::size_t i = 0; i < arms_.size(); i++)
+        {
+            const double precision = 1.0 / (PRIOR_STD_DEV * PRIOR_STD_DEV) + arms_[i].weight_ / variance;
+            const double mean = (priorMean / (PRIOR_STD_DEV * PRIOR_STD_DEV) + arms_[i].weightedSum_ / variance) / precision;
+            const double draw = std::normal_distribution<double>(mean, 1.0 / std::sqrt(precision))(generator_);
+            if (draw < lowest)
+            {
+                lowest = draw;
+                chosen = i;
+            }
+        }
+        return {arms_[chosen].cap_, chosen != exploitation_};
+    }
+
+    /*
+      update - records the cost of the window measured with the decision, returns true
+      if the exploitation cap has changed
+    */
+    bool update(const Decision& decision, double cost, double durationInSeconds)
+    {
+        const double decay = std::pow(0.5, durationInSeconds / HALF_LIFE_IN_SECONDS);
+        for (auto&& arm : arms_)
+        {
+            arm.count_ *= decay;
+            arm.weight_ *= decay;
+            arm.weightedSum_ *= decay;
+            arm.weightedSquares_ *= decay;
+        }
+        totalTime_ += durationInSeconds;
+        if (decision.isExploration_)
+        {
+            explorationTime_ += durationInSeconds;
+        }
+        auto arm = std::find_if(arms_.begin(), arms_.end(), [&](const Arm& a) { return a.cap_ == decision.capInWatts_; });
+        if (arm == arms_.end() || !std::isfinite(cost))
+        {
+            return false;
+        }
+        // a window n times the nominal one has n times lower variance of the cost
+        const double weight = durationInSeconds / nominalWindowInSeconds_;
+        arm->count_ += 1.0;
+        arm->weight_ += weight;
+        arm->weightedSum_ += weight * cost;
+        arm->weightedSquares_ += weight * cost * cost;
+        return updateExploitation();
+    }
+
+    double getExploitationCapInWatts() const { return arms_[exploitation_].cap_; }
+    double getExplorationFraction() const { return totalTime_ > 0.0 ? explorationTime_ / totalTime_ : 0.0; }
+
+private:
+    struct Arm
+    {
+        double cap_;
+        double count_ {0.0};
+        double weight_ {0.0};
+        double weightedSum_ {0.0};
+        double weightedSquares_ {0.0};
+
+        double getMean() const { return weightedSum_ / weight_; }
+    };
+
+    void centerArmsAround(double capInWatts)
+    {
+        std::vector<Arm> arms;
+        for (int k = -NEIGHBOURS; k <= NEIGHBOURS; k++)
+        {
+            const double cap = capInWatts + k * step_;
+            if (cap < minCap_ - 1e-9 || cap > maxCap_ + 1e-9)
+            {
+                continue;
+            }
+            // the statistics of the arms which stay are kept
+            auto existing = std::find_if(arms_.begin(), arms_.end(), [&](const Arm& a) { return std::abs(a.cap_ - cap) < 1e-9; });
+            arms.push_back(existing != arms_.end() ? *existing : Arm {cap});
+            if (k == 0)
+            {
+                exploitation_ = arms.size() - 1;
+            }
+        }
+        arms_ = std::move(arms);
+    }
+
+    std::pair<double, double> getPriorMeanAndNoiseVariance() const
+    {
+        const auto& exploitation = arms_[exploitation_];
+        const double priorMean = exploitation.weight_ > 0.0 ? exploitation.getMean() : 1.0;
+        double squares = 0.0;
+        double dof = 0.0;
+        // the weighted squares around the weighted mean have count - 1 degrees of freedom
+        // of the nominal window variance, whatever the weights are
+        for (auto&& arm : arms_)
+        {
+            if (arm.count_ > 1.0)
+            {
+                squares += std::max(0.0, arm.weightedSquares_ - arm.weightedSum_ * arm.getMean());
+                dof += arm.count_ - 1.0;
+            }
+        }
+        const double variance = dof > 0.0 ? squares / dof : PRIOR_STD_DEV * PRIOR_STD_DEV;
+        return {priorMean, std::max(variance, MIN_STD_DEV * MIN_STD_DEV)};
+    }
+
+    bool updateExploitation()
+    {
+        const auto variance = getPriorMeanAndNoiseVariance().second;
+        const auto& exploitation = arms_[exploitation_];
+        if (exploitation.weight_ < MIN_WEIGHT)
+        {
+            return false;
+        }
+        std::size_t best = exploitation_;
+        double bestMargin = 0.0;
+        for (std::size_t i = 0; i < arms_.size(); i++)
+        {
+            if (i == exploitation_ || arms_[i].weight_ < MIN_WEIGHT)
+            {
+                continue;
+            }
+            const double stdError = std::sqrt(variance / exploitation.weight_ + variance / arms_[i].weight_);
+            const double margin = (exploitation.getMean() - arms_[i].getMean()) / stdError;
+            if (margin > SWITCH_Z && margin > bestMargin)
+            {
+                best = i;
+                bestMargin = margin;
+            }
+        }
+        if (best == exploitation_)
+        {
+            return false;
+        }
+        centerArmsAround(arms_[best].cap_);
+        return true;
+    }
+
+    static constexpr int NEIGHBOURS {2};
+    static constexpr double ARM_SPACING {0.05};
+    static constexpr double HALF_LIFE_IN_SECONDS {120.0};
+    static constexpr double PRIOR_STD_DEV {0.1}; // relative cost, i.e., 10% of the reference
+    static constexpr double MIN_STD_DEV {0.005};
+    static constexpr double MIN_WEIGHT {2.0};
+    static constexpr double SWITCH_Z {1.645};
+
+    double minCap_;
+    double maxCap_;
+    double step_;
+    double explorationFraction_;
+    double nominalWindowInSeconds_;
+    std::mt19937 generator_;
+    std::vector<Arm> arms_;
+    std::size_t exploitation_ {0};
+    double explorationTime_ {0.0};
+    double totalTime_ {0.0};
+};
@@ -0,0 +1,91 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "data_structures/streaming_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/*
+  CusumDetector - two-sided CUSUM change-point detector of a stream of samples
+
+  The first warmUpSamples values after (re)start estimate the baseline mean and
+  standard deviation. Then every sample is standardized against the baseline and
+  accumulated into the upper and lower cumulative sums with the drift allowance k
+  (in standard deviations). A change is reported when either sum exceeds the
+  threshold h, i.e., the smaller h the more sensitive the detector. The standard
+  deviation is floored at minRelativeStdDev of the baseline mean, so that nearly
+  constant signals do not alarm on negligible shifts.
+*/
+class CusumDetector
+{
+public:
+    CusumDetector(double h = 8.0, double k = 1.0, std::size_t warmUpSamples = 50, double minRelativeStdDev = 0.01) :
+        h_(h), k_(k), warmUpSamples_(warmUpSamples), minRelativeStdDev_(minRelativeStdDev)
+    {
+    }
+
+    /*
+      update - returns true if the sample completes the detection of a change,
+      the detector has to be restarted to look for the next one
+    */
+    bool update(double x)
+    {
+        if (!std::isfinite(x) || changeDetected_)
+        {
+            return false;
+        }
+        if (baseline_.getCount() < warmUpSamples_)
+        {
+            baseline_.add(x);
+            return false;
+        }
+        const double sigma = std::max(baseline_.getStdDev(), minRelativeStdDev_ * std::abs(baseline_.getMean()));
+        if (sigma <= 0.0)
+        {
+            return false;
+        }
+        const double z = (x - baseline_.getMean()) / sigma;
+        upper_ = std::max(0.0, upper_ + z - k_);
+        lower_ = std::max(0.0, lower_ - z - k_);
+        changeDetected_ = upper_ > h_ || lower_ > h_;
+        return changeDetected_;
+    }
+
+    void restart()
+    {
+        baseline_.reset();
+        upper_ = lower_ = 0.0;
+        changeDetected_ = false;
+    }
+
+    bool isLearningBaseline() const { return baseline_.getCount() < warmUpSamples_; }
+    bool isChangeDetected() const { return changeDetected_; }
+    double getUpperSum() const { return upper_; }
+    double getLowerSum() const { return lower_; }
+
+private:
+    double h_;
+    double k_;
+    std::size_t warmUpSamples_;
+    double minRelativeStdDev_;
+    StreamingStatistics baseline_;
+    double upper_ {0.0};
+    double lower_ {0.0};
+    bool changeDetected_ {false};
+};
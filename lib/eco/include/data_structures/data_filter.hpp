@@ -16,23 +16,22 @@
 
 #pragma once
 
-#include <vector>
+#include "data_structures/streaming_estimators.hpp"
 
+/*
+  DataFilter - SMA and relative spread of the last size data points, O(1) per call
+*/
 class DataFilter {
 public:
     DataFilter() = delete;
     DataFilter(int size) :
-        filterSize_(size) {}
+        sma_(size), extrema_(size) {}
     double getSMA() const;
-    double getRelativeError();
+    double getRelativeError() const;
     double getCleanedRelativeError() const;
 
     void storeDataPoint(double dataPoint);
 private:
-    void shiftActiveIndex();
-    double getSum() const;
-
-    std::vector<double> data_;
-    unsigned filterSize_;
-    unsigned activeIndex_ {0};
-};
\ No newline at end of file
+    MovingAverage sma_;
+    SlidingMinMax extrema_;
+};
@@ -0,0 +1,125 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "data_structures/power_and_perf_result.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <vector>
+
+/*
+  MeasurementCache - windows measured for power caps, weighted by their age
+
+  The raw instructions, time and energy are kept instead of the costs, as the costs are
+  relative to the reference of their own tuning phase. A measurement taken age seconds
+  ago has the weight 0.5^(age / halfLifeInSeconds), the estimate for a cap is the window
+  with the weighted sums of the instructions, time and energy of its measurements, so
+  that its cost can be computed against the current reference. Measurements with a
+  negligible weight are evicted.
+*/
+class MeasurementCache
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    MeasurementCache(double halfLifeInSeconds) :
+        halfLifeInSeconds_(halfLifeInSeconds)
+    {
+    }
+
+    void add(int capInMicroWatts, const PowAndPerfResult& result, Clock::time_point time = Clock::now())
+    {
+        if (result.instructionsCount_ > 0.0 && result.periodInSeconds_ > 0.0 && std::isfinite(result.energyInJoules_))
+        {
+            measurements_[capInMicroWatts].push_back({result, time});
+        }
+    }
+
+    std::optional<PowAndPerfResult> getEstimate(int capInMicroWatts, Clock::time_point now = Clock::now()) const
+    {
+        auto it = measurements_.find(capInMicroWatts);
+        if (it == measurements_.end())
+        {
+            return std::nullopt;
+        }
+        double instructions = 0.0, time = 0.0, energy = 0.0, memoryEnergy = 0.0;
+        for (auto&& measurement : it->second)
+        {
+            const double weight = getWeight(measurement.time_, now);
+            instructions += weight * measurement.result_.instructionsCount_;
+            time += weight * measurement.result_.periodInSeconds_;
+            energy += weight * measurement.result_.energyInJoules_;
+            memoryEnergy += weight * measurement.result_.memoryEnergyInJoules_;
+        }
+        if (!(time > 0.0))
+        {
+            return std::nullopt;
+        }
+        PowAndPerfResult estimate(instructions, time, capInMicroWatts / 1e6, energy, energy / time,
+                                  memoryEnergy / time, energy / time);
+        estimate.memoryEnergyInJoules_ = memoryEnergy;
+        return estimate;
+    }
+
+    /*
+      clear - forgets all the measurements, e.g., after the application has changed its phase
+    */
+    void clear() { measurements_.clear(); }
+
+    void evictStale(Clock::time_point now = Clock::now())
+    {
+        for (auto it = measurements_.begin(); it != measurements_.end();)
+        {
+            auto& caps = it->second;
+            std::vector<Measurement> fresh;
+            for (auto&& measurement : caps)
+            {
+                if (getWeight(measurement.time_, now) >= MIN_WEIGHT)
+                {
+                    fresh.push_back(measurement);
+                }
+            }
+            caps = std::move(fresh);
+            it = caps.empty() ? measurements_.erase(it) : std::next(it);
+        }
+    }
+
+    bool isEmpty() const { return measurements_.empty(); }
+
+private:
+    struct Measurement
+    {
+        PowAndPerfResult result_;
+        Clock::time_point time_;
+    };
+
+    double getWeight(Clock::time_point time, Clock::time_point now) const
+    {
+        const double age = std::chrono::duration<double>(now - time).count();
+        return std::pow(0.5, std::max(0.0, age) / halfLifeInSeconds_);
+    }
+
+    static constexpr double MIN_WEIGHT {0.01};
+
+    double halfLifeInSeconds_;
+    std::map<int, std::vector<Measurement>> measurements_;
+};
@@ -0,0 +1,179 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+/*
+  PeriodicityDetector - estimates the dominant period of a uniformly sampled stream
+  (e.g., power of an application with an outer iteration loop) with autocorrelation
+
+  The last maxSamples samples are kept. The linear trend is removed and the normalized
+  autocorrelation is computed for lags up to a third of the samples, so that at least
+  three periods are observed. The period is the first autocorrelation peak past the
+  first zero crossing which is not much lower than the highest one (to avoid picking
+  its multiples), refined with parabolic interpolation. No period is reported when the
+  peak correlation is below minCorrelation.
+*/
+class PeriodicityDetector
+{
+public:
+    PeriodicityDetector(std::size_t maxSamples = 4096, double minCorrelation = 0.5) :
+        maxSamples_(maxSamples), minCorrelation_(minCorrelation)
+    {
+    }
+
+    void append(double value, double samplingPeriodInSeconds)
+    {
+        if (!std::isfinite(value) || !(samplingPeriodInSeconds > 0.0))
+        {
+            return;
+        }
+        samples_.push_back(value);
+        periods_.push_back(samplingPeriodInSeconds);
+        periodsSum_ += samplingPeriodInSeconds;
+        if (samples_.size() > maxSamples_)
+        {
+            samples_.pop_front();
+            periodsSum_ -= periods_.front();
+            periods_.pop_front();
+        }
+    }
+
+    void reset()
+    {
+        samples_.clear();
+        periods_.clear();
+        periodsSum_ = 0.0;
+        correlation_ = 0.0;
+    }
+
+    std::size_t getNumberOfSamples() const { return samples_.size(); }
+
+    /*
+      getPeakCorrelation - autocorrelation at the period found by the last estimatePeriodInSeconds()
+    */
+    double getPeakCorrelation() const { return correlation_; }
+
+    /*
+      estimatePeriodInSeconds - returns 0.0 if no clear period is observed
+    */
+    double estimatePeriodInSeconds()
+    {
+        correlation_ = 0.0;
+        const std::size_t n = samples_.size();
+        const std::size_t maxLag = n / 3;
+        if (maxLag < MIN_LAG + 2)
+        {
+            return 0.0;
+        }
+        auto acf = autocorrelation(detrended(), maxLag);
+
+        std::size_t lag = 1;
+        while (lag <= maxLag && acf[lag] > 0.0)
+        {
+            lag++;
+        }
+        double highestPeak = 0.0;
+        std::vector<std::size_t> peaks;
+        for (lag = std::max(lag, MIN_LAG); lag < maxLag; lag++)
+        {
+            if (acf[lag] > 0.0 && acf[lag] >= acf[lag - 1] && acf[lag] > acf[lag + 1])
+            {
+                peaks.push_back(lag);
+                highestPeak = std::max(highestPeak, acf[lag]);
+            }
+        }
+        if (peaks.empty() || highestPeak < minCorrelation_)
+        {
+            return 0.0;
+        }
+        std::size_t best = peaks.front();
+        for (auto&& peak : peaks)
+        {
+            if (acf[peak] >= SUBHARMONIC_TOLERANCE * highestPeak)
+            {
+                best = peak;
+                break;
+            }
+        }
+        correlation_ = acf[best];
+        // vertex of the parabola through the peak and its neighbours
+        const double denominator = acf[best - 1] - 2.0 * acf[best] + acf[best + 1];
+        const double shift = denominator != 0.0 ? 0.5 * (acf[best - 1] - acf[best + 1]) / denominator : 0.0;
+        return (best + shift) * periodsSum_ / n;
+    }
+
+private:
+    std::vector<double> detrended() const
+    {
+        const std::size_t n = samples_.size();
+        // least squares line over indices 0..n-1
+        const double meanIdx = (n - 1) / 2.0;
+        double meanVal = 0.0;
+        for (auto&& s : samples_) meanVal += s;
+        meanVal /= n;
+        double sxy = 0.0, sxx = 0.0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            sxy += (i - meanIdx) * (samples_[i] - meanVal);
+            sxx += (i - meanIdx) * (i - meanIdx);
+        }
+        const double slope = sxx > 0.0 ? sxy / sxx : 0.0;
+        std::vector<double> x(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            x[i] = samples_[i] - meanVal - slope * (i - meanIdx);
+        }
+        return x;
+    }
+
+    static std::vector<double> autocorrelation(const std::vector<double>& x, std::size_t maxLag)
+    {
+        std::vector<double> acf(maxLag + 1, 0.0);
+        double energy = 0.0;
+        for (auto&& v : x) energy += v * v;
+        if (energy <= 0.0)
+        {
+            return acf;
+        }
+        for (std::size_t lag = 0; lag <= maxLag; lag++)
+        {
+            double sum = 0.0;
+            for (std::size_t i = 0; i + lag < x.size(); i++)
+            {
+                sum += x[i] * x[i + lag];
+            }
+            // unbiased normalization, so the peaks at longer lags are not attenuated
+            acf[lag] = (sum / (x.size() - lag)) / (energy / x.size());
+        }
+        return acf;
+    }
+
+    static constexpr std::size_t MIN_LAG {2};
+    static constexpr double SUBHARMONIC_TOLERANCE {0.85};
+
+    std::size_t maxSamples_;
+    double minCorrelation_;
+    std::deque<double> samples_;
+    std::deque<double> periods_;
+    double periodsSum_ {0.0};
+    double correlation_ {0.0};
+};
@@ -45,6 +45,13 @@ struct PowAndPerfResult {
     double checkPlusMetric(PowAndPerfResult ref, double k);
     friend std::ostream& operator<<(std::ostream&, const PowAndPerfResult&);
     bool isRightBetter(PowAndPerfResult&, TargetMetric = TargetMetric::MIN_E);
+    /*
+      getRelativeCost - value of the target metric relative to the reference (lower is better)
+
+      1.0 means as good as the reference. For MIN_M_PLUS the metric has to be computed
+      first with checkPlusMetric().
+    */
+    double getRelativeCost(const PowAndPerfResult& reference, TargetMetric = TargetMetric::MIN_E) const;
     double instructionsCount_ {0.01};
     double periodInSeconds_ {0.01};
     double appliedPowerCapInWatts_ {0.01};
@@ -53,6 +60,19 @@ struct PowAndPerfResult {
     double averageMemoryPowerInWatts_ {0.01};
     double filteredPowerOfLimitedDomainInWatts_ {0.01}; // assume that either Core or Memory is limited
     double myPlusMetric_ {1.0};
+    double memoryEnergyInJoules_ {0.0};
+    /*
+      withMemoryEnergy - copy of the result with the memory energy added to the energy,
+      so that all the metrics are computed for the combined (e.g., PKG+DRAM) energy
+    */
+    PowAndPerfResult withMemoryEnergy() const
+    {
+        PowAndPerfResult result = *this;
+        result.energyInJoules_ += memoryEnergyInJoules_;
+        result.averageCorePowerInWatts_ = result.energyInJoules_ / result.periodInSeconds_;
+        result.memoryEnergyInJoules_ = 0.0;
+        return result;
+    }
 
     friend PowAndPerfResult& operator+=(PowAndPerfResult& left, const PowAndPerfResult& right)
     {
@@ -70,8 +90,8 @@ struct PowAndPerfResult {
         // will be informative enough when accumulating several PowAndPerfResults
         left.filteredPowerOfLimitedDomainInWatts_ += right.filteredPowerOfLimitedDomainInWatts_;
         left.filteredPowerOfLimitedDomainInWatts_ /= 2;
-        left.averageMemoryPowerInWatts_ += right.averageMemoryPowerInWatts_;
-        left.averageMemoryPowerInWatts_ /= 2;
+        left.memoryEnergyInJoules_ += right.memoryEnergyInJoules_;
+        left.averageMemoryPowerInWatts_ = left.memoryEnergyInJoules_ / left.periodInSeconds_;
 
         return left;
     }
@@ -0,0 +1,44 @@
+/*
+   Copyright 2022-2024, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// devices accumulated alongside the tuned one, e.g., host CPU of a GPU job
+static constexpr std::size_t MAX_AUXILIARY_DEVICES {8};
+
+using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+struct PowerAndPerfState
+{
+    PowerAndPerfState() = delete;
+    PowerAndPerfState(double pow, unsigned long long ker, TimePoint t, double energy = 0.0) :
+        power_(pow), kernelsCount_(ker), time_(t), energy_(energy)
+    {
+    }
+    double power_;
+    unsigned long long kernelsCount_;
+    TimePoint time_;
+    // reading of the device cumulative energy counter in Joules
+    double energy_;
+    // reading of the device memory (e.g., DRAM) energy counter, 0.0 if not measured
+    double memoryEnergy_ {0.0};
+    // readings of the auxiliary devices' energy counters taken at the same time_
+    std::array<double, MAX_AUXILIARY_DEVICES> auxiliaryEnergy_ {};
+};
@@ -0,0 +1,94 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "data_structures/streaming_statistics.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+/*
+  SequentialProbabilityRatioTest - one-sided Wald test of a candidate window being
+  measured against the cost of the incumbent
+
+  H0: the mean cost equals incumbentCost, H1: it is worse by relativeMargin. The
+  log-likelihood ratio of normally distributed costs is computed for the cost of the
+  window so far, with the standard deviation estimated from the per-sample costs. The
+  window cost is a ratio of sums like the incumbent one, while the mean of per-sample
+  ratios is biased upward for short noisy samples. H1 is accepted (the candidate is
+  dominated) when the ratio exceeds log((1 - beta) / alpha), alpha being the risk of
+  dropping a candidate as good as the incumbent. Accepting H0 does not end anything,
+  the window of a promising candidate is always measured in full.
+*/
+class SequentialProbabilityRatioTest
+{
+public:
+    SequentialProbabilityRatioTest(
+        double incumbentCost,
+        double relativeMargin = 0.05,
+        double alpha = 0.01,
+        double beta = 0.2,
+        std::size_t minSamples = 10) :
+        mu0_(incumbentCost), mu1_(incumbentCost * (1.0 + relativeMargin)),
+        threshold_(std::log((1.0 - beta) / alpha)), minSamples_(minSamples)
+    {
+    }
+
+    /*
+      update - adds the cost of the last sample and the cost of the whole window so far,
+      returns true once the candidate is dominated
+    */
+    bool update(double sampleCost, double windowCost)
+    {
+        if (std::isfinite(sampleCost) && std::isfinite(windowCost))
+        {
+            costs_.add(sampleCost);
+            windowCost_ = windowCost;
+        }
+        return isDominated();
+    }
+
+    bool isDominated() const
+    {
+        if (costs_.getCount() < minSamples_ || !(mu1_ > mu0_))
+        {
+            return false;
+        }
+        const double variance = costs_.getVariance();
+        if (variance <= 0.0)
+        {
+            return windowCost_ > mu1_;
+        }
+        return getLogLikelihoodRatio() > threshold_;
+    }
+
+    double getLogLikelihoodRatio() const
+    {
+        const double variance = costs_.getVariance();
+        return costs_.getCount() * (mu1_ - mu0_) / variance * (windowCost_ - 0.5 * (mu0_ + mu1_));
+    }
+
+    std::size_t getCount() const { return costs_.getCount(); }
+
+private:
+    double mu0_;
+    double mu1_;
+    double threshold_;
+    std::size_t minSamples_;
+    StreamingStatistics costs_;
+    double windowCost_ {0.0};
+};
@@ -0,0 +1,67 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+/*
+  SlidingMinMax - minimum and maximum of the last windowSize values
+
+  Monotonic deques of (index, value) pairs give amortized O(1) updates
+  and O(1) queries instead of rescanning the window.
+*/
+class SlidingMinMax
+{
+public:
+    SlidingMinMax(std::size_t windowSize) :
+        windowSize_(windowSize)
+    {
+    }
+
+    void push(double x)
+    {
+        while (!min_.empty() && min_.back().second >= x) min_.pop_back();
+        while (!max_.empty() && max_.back().second <= x) max_.pop_back();
+        min_.emplace_back(next_, x);
+        max_.emplace_back(next_, x);
+        next_++;
+        const std::size_t oldest = next_ > windowSize_ ? next_ - windowSize_ : 0;
+        if (min_.front().first < oldest) min_.pop_front();
+        if (max_.front().first < oldest) max_.pop_front();
+    }
+
+    void reset()
+    {
+        min_.clear();
+        max_.clear();
+        next_ = 0;
+    }
+
+    bool isEmpty() const { return min_.empty(); }
+    // number of values in the window
+    std::size_t getCount() const { return next_ < windowSize_ ? next_ : windowSize_; }
+    double getMin() const { return min_.front().second; }
+    double getMax() const { return max_.front().second; }
+
+private:
+    std::size_t windowSize_;
+    std::size_t next_ {0};
+    std::deque<std::pair<std::size_t, double>> min_;
+    std::deque<std::pair<std::size_t, double>> max_;
+};
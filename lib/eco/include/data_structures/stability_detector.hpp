@@ -0,0 +1,167 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "data_structures/sliding_min_max.hpp"
+#include "data_structures/streaming_statistics.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+
+/*
+  StabilityDetector - decides if the last windowSize samples of a signal are stationary
+
+  The window is split into the older and the newer half, both tracked with sliding
+  Welford statistics. The signal is stable if:
+  - all samples lie within the relativeTolerance band (sliding min/max), which lets
+    clean signals be accepted after a few samples, or
+  - the mean of the newer half is equivalent to the mean of the older one within
+    relativeTolerance of the mean, i.e., the 90% Welch confidence interval of the
+    difference lies within the band (two one-sided tests), or
+  - the window is full and the Welch t-test finds no significant difference, which
+    accepts signals too noisy for the band.
+  When the halves differ with high confidence the older half is dropped, so that
+  samples from before a transient (e.g., the start-up) do not delay the decision.
+  The checks are amortized O(1) per sample. Samples are assumed independent, strongly
+  autocorrelated signals need more samples per half to be tested reliably.
+*/
+class StabilityDetector
+{
+public:
+    StabilityDetector(std::size_t windowSize = 200, double relativeTolerance = 0.03, std::size_t minSamplesPerHalf = 10) :
+        windowSize_(windowSize), relativeTolerance_(relativeTolerance),
+        minSamplesPerHalf_(minSamplesPerHalf), extrema_(windowSize)
+    {
+    }
+
+    void append(double x)
+    {
+        if (!std::isfinite(x))
+        {
+            return;
+        }
+        window_.push_back(x);
+        newer_.add(x);
+        extrema_.push(x);
+        if (window_.size() > windowSize_)
+        {
+            older_.remove(window_.front());
+            window_.pop_front();
+        }
+        rebalance();
+        if (older_.getCount() >= minSamplesPerHalf_ && getWelchT() > CHANGE_T)
+        {
+            dropOlderHalf();
+        }
+    }
+
+    void reset()
+    {
+        window_.clear();
+        older_.reset();
+        newer_.reset();
+        extrema_.reset();
+    }
+
+    double getMean() const
+    {
+        auto all = older_;
+        all.merge(newer_);
+        return all.getMean();
+    }
+
+    bool isStable() const
+    {
+        if (older_.getCount() < MIN_SAMPLES_PER_HALF_FOR_RANGE)
+        {
+            return false;
+        }
+        const double band = relativeTolerance_ * std::abs(getMean());
+        if (extrema_.getMax() - extrema_.getMin() <= band)
+        {
+            return true;
+        }
+        if (older_.getCount() < minSamplesPerHalf_)
+        {
+            return false;
+        }
+        const double olderVar = older_.getVariance() / older_.getCount();
+        const double newerVar = newer_.getVariance() / newer_.getCount();
+        const double stdError = std::sqrt(olderVar + newerVar);
+        // Welch-Satterthwaite degrees of freedom
+        const double dofDenominator = olderVar * olderVar / (older_.getCount() - 1) + newerVar * newerVar / (newer_.getCount() - 1);
+        const double dof = dofDenominator > 0.0 ? std::pow(stdError, 4) / dofDenominator : INFINITY;
+        const double diff = std::abs(newer_.getMean() - older_.getMean());
+        const double tQuantile = tQuantile95(dof);
+        if (diff + tQuantile * stdError <= band)
+        {
+            return true;
+        }
+        return window_.size() == windowSize_ && diff <= tQuantile * stdError;
+    }
+
+private:
+    // the oldest samples of the newer half move to the older one
+    void rebalance()
+    {
+        while (older_.getCount() < window_.size() / 2)
+        {
+            const double boundary = window_[older_.getCount()];
+            newer_.remove(boundary);
+            older_.add(boundary);
+        }
+    }
+
+    void dropOlderHalf()
+    {
+        window_.erase(window_.begin(), window_.begin() + older_.getCount());
+        older_.reset();
+        extrema_.reset();
+        for (auto&& x : window_)
+        {
+            extrema_.push(x);
+        }
+        rebalance();
+    }
+
+    double getWelchT() const
+    {
+        const double stdError = std::sqrt(older_.getVariance() / older_.getCount() + newer_.getVariance() / newer_.getCount());
+        const double diff = std::abs(newer_.getMean() - older_.getMean());
+        return stdError > 0.0 ? diff / stdError : (diff > 0.0 ? INFINITY : 0.0);
+    }
+
+    // one-sided 95% quantile of Student's t, Cornish-Fisher expansion around the normal one
+    static double tQuantile95(double dof)
+    {
+        constexpr double z = 1.6449;
+        return z + (z * z * z + z) / (4.0 * dof) + (5 * std::pow(z, 5) + 16 * z * z * z + 3 * z) / (96.0 * dof * dof);
+    }
+
+    static constexpr std::size_t MIN_SAMPLES_PER_HALF_FOR_RANGE {5};
+    // evaluated after every sample, hence far beyond the usual quantiles to keep false drops rare
+    static constexpr double CHANGE_T {4.0};
+
+    std::size_t windowSize_;
+    double relativeTolerance_;
+    std::size_t minSamplesPerHalf_;
+    std::deque<double> window_;
+    StreamingStatistics older_;
+    StreamingStatistics newer_;
+    SlidingMinMax extrema_;
+};
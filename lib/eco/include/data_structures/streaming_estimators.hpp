@@ -0,0 +1,183 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+/*
+  Incremental estimators of sampled signals, all of them updated per sample without
+  rescanning their windows:
+  - StreamingStatistics - Welford mean and variance (optionally sliding with remove()),
+  - SlidingMinMax - window minimum and maximum with monotonic deques,
+  - MovingAverage - simple moving average with a running sum over a ring buffer,
+  - ExponentialMovingAverage - EWMA with a given smoothing factor,
+  - HampelFilter - replaces outliers with the median of the last few samples.
+*/
+
+#include "data_structures/sliding_min_max.hpp"
+#include "data_structures/streaming_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+/*
+  MovingAverage - SMA of the last windowSize values
+
+  The sum is updated with the incoming and the outgoing value and recomputed once
+  per full turn of the ring, which bounds the accumulated rounding error at amortized
+  O(1) cost.
+*/
+class MovingAverage
+{
+public:
+    MovingAverage(std::size_t windowSize) :
+        windowSize_(windowSize)
+    {
+        data_.reserve(windowSize_);
+    }
+
+    void add(double x)
+    {
+        if (data_.size() < windowSize_)
+        {
+            data_.push_back(x);
+            sum_ += x;
+            return;
+        }
+        sum_ += x - data_[oldest_];
+        data_[oldest_] = x;
+        if (++oldest_ == windowSize_)
+        {
+            oldest_ = 0;
+            sum_ = 0.0;
+            for (auto&& value : data_) sum_ += value;
+        }
+    }
+
+    void reset()
+    {
+        data_.clear();
+        oldest_ = 0;
+        sum_ = 0.0;
+    }
+
+    std::size_t getCount() const { return data_.size(); }
+    double getSum() const { return sum_; }
+    // NaN for an empty window
+    double getMean() const { return data_.empty() ? NAN : sum_ / data_.size(); }
+
+private:
+    std::size_t windowSize_;
+    std::vector<double> data_;
+    std::size_t oldest_ {0};
+    double sum_ {0.0};
+};
+
+/*
+  ExponentialMovingAverage - y = alpha * x + (1 - alpha) * y, the first value initializes y
+*/
+class ExponentialMovingAverage
+{
+public:
+    ExponentialMovingAverage(double alpha) :
+        alpha_(alpha)
+    {
+    }
+
+    double add(double x)
+    {
+        value_ = isInitialized_ ? alpha_ * x + (1.0 - alpha_) * value_ : x;
+        isInitialized_ = true;
+        return value_;
+    }
+
+    void reset() { isInitialized_ = false; }
+
+    bool isInitialized() const { return isInitialized_; }
+    double getValue() const { return isInitialized_ ? value_ : NAN; }
+
+private:
+    double alpha_;
+    double value_ {0.0};
+    bool isInitialized_ {false};
+};
+
+/*
+  HampelFilter - outlier rejector over the last windowSize values
+
+  A value farther than nSigmas scaled median absolute deviations from the median of
+  the window is replaced with that median. The window is meant to be short (a few
+  samples), the cost is O(windowSize) per value regardless of the length of the
+  windows of the other estimators.
+*/
+class HampelFilter
+{
+public:
+    HampelFilter(std::size_t windowSize = 7, double nSigmas = 3.0) :
+        windowSize_(windowSize), nSigmas_(nSigmas)
+    {
+    }
+
+    double filter(double x)
+    {
+        if (window_.size() < windowSize_)
+        {
+            window_.push_back(x);
+            return x;
+        }
+        scratch_.assign(window_.begin(), window_.end());
+        const double median = getMedian(scratch_);
+        for (auto&& value : scratch_) value = std::abs(value - median);
+        // 1.4826 scales MAD to the standard deviation of normally distributed values
+        const double sigma = 1.4826 * getMedian(scratch_);
+        window_.pop_front();
+        window_.push_back(x);
+        if (std::abs(x - median) > nSigmas_ * sigma && sigma > 0.0)
+        {
+            rejected_++;
+            return median;
+        }
+        return x;
+    }
+
+    void reset()
+    {
+        window_.clear();
+        rejected_ = 0;
+    }
+
+    std::size_t getNumberOfRejected() const { return rejected_; }
+
+private:
+    static double getMedian(std::vector<double>& values)
+    {
+        const auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        if (values.size() % 2)
+        {
+            return *middle;
+        }
+        return 0.5 * (*middle + *std::max_element(values.begin(), middle));
+    }
+
+    std::size_t windowSize_;
+    double nSigmas_;
+    std::deque<double> window_;
+    std::vector<double> scratch_;
+    std::size_t rejected_ {0};
+};
@@ -0,0 +1,83 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+/*
+  StreamingStatistics - running mean and variance (Welford's algorithm)
+
+  Numerically stable single-pass estimate, suitable for accumulating per-sample
+  values inside a measurement window without storing them.
+*/
+class StreamingStatistics
+{
+public:
+    void add(double x)
+    {
+        count_++;
+        const double delta = x - mean_;
+        mean_ += delta / count_;
+        m2_ += delta * (x - mean_);
+    }
+
+    /*
+      remove - withdraws a value added before, allows for sliding windows
+    */
+    void remove(double x)
+    {
+        if (count_ <= 1)
+        {
+            reset();
+            return;
+        }
+        count_--;
+        const double delta = x - mean_;
+        mean_ -= delta / count_;
+        m2_ = std::max(0.0, m2_ - delta * (x - mean_));
+    }
+
+    void reset() { *this = StreamingStatistics(); }
+
+    std::size_t getCount() const { return count_; }
+    double getMean() const { return mean_; }
+    // unbiased sample variance, 0 for less than two values
+    double getVariance() const { return count_ > 1 ? m2_ / (count_ - 1) : 0.0; }
+    double getStdDev() const { return std::sqrt(getVariance()); }
+    // standard error of the mean
+    double getStdError() const { return count_ > 1 ? std::sqrt(getVariance() / count_) : INFINITY; }
+
+    /*
+      merge - combines statistics of two disjoint sets of values (Chan et al.)
+    */
+    void merge(const StreamingStatistics& other)
+    {
+        if (!other.count_) return;
+        const auto count = count_ + other.count_;
+        const double delta = other.mean_ - mean_;
+        mean_ += delta * other.count_ / count;
+        m2_ += other.m2_ + delta * delta * count_ * other.count_ / count;
+        count_ = count;
+    }
+
+private:
+    std::size_t count_ {0};
+    double mean_ {0.0};
+    double m2_ {0.0};
+};
@@ -0,0 +1,147 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "data_structures/power_and_perf_result.hpp"
+#include "eco_constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+
+/*
+  WindowCalibrator - shortest tuning window measuring the target metric with the
+  given relative standard error
+
+  Consecutive samples taken at the same power cap form a segment. Within segments the variance and the lag-1 autocorrelation of the log of
+  the per-sample metric are pooled, so the level differences between the caps do not
+  count as noise. The window needs n = (sigma / targetRelativeError)^2 * (1 + rho) / (1 - rho)
+  samples, i.e., the autocorrelated samples are worth less than independent ones.
+*/
+class WindowCalibrator
+{
+public:
+    WindowCalibrator(double targetRelativeError, std::size_t minSamplesPerWindow = 10) :
+        targetRelativeError_(targetRelativeError), minSamplesPerWindow_(minSamplesPerWindow)
+    {
+    }
+
+    void setTargetMetric(TargetMetric metric) { metric_ = metric; }
+
+    void append(const PowAndPerfResult& sample)
+    {
+        // EDP per instruction squared is P/IPS^2, the plus metric is dominated by E/instr
+        const double metric = metric_ == TargetMetric::MIN_E_X_T ?
+                              1.0 / sample.getEnergyTimeProd() : sample.getEnergyPerInstr();
+        if (!std::isfinite(metric) || metric <= 0.0 || !(sample.periodInSeconds_ > 0.0))
+        {
+            return;
+        }
+        if (sample.appliedPowerCapInWatts_ != segmentCapInWatts_)
+        {
+            closeSegment();
+            segmentCapInWatts_ = sample.appliedPowerCapInWatts_;
+        }
+        // shifted by the first value of the segment, the raw logs are far from 0
+        if (!segmentCount_)
+        {
+            shift_ = std::log(metric);
+        }
+        const double x = std::log(metric) - shift_;
+        if (segmentCount_)
+        {
+            segmentLagProducts_ += previous_ * x;
+            segmentLagHeads_ += previous_;
+            segmentLagTails_ += x;
+        }
+        segmentSum_ += x;
+        segmentSquares_ += x * x;
+        segmentCount_++;
+        previous_ = x;
+        periodsSum_ += sample.periodInSeconds_;
+        samples_++;
+    }
+
+    /*
+      getWindowInSeconds - std::nullopt until MIN_CALIBRATION_SAMPLES are collected
+    */
+    std::optional<double> getWindowInSeconds()
+    {
+        closeSegment();
+        if (samples_ < MIN_CALIBRATION_SAMPLES || pooledDof_ <= 0.0)
+        {
+            return std::nullopt;
+        }
+        const double variance = pooledSquares_ / pooledDof_;
+        const double rho = lagDof_ > 0.0 && variance > 0.0 ? std::clamp(pooledLagProducts_ / lagDof_ / variance, 0.0, MAX_RHO) : 0.0;
+        const double samplesPerWindow = variance / (targetRelativeError_ * targetRelativeError_) * (1.0 + rho) / (1.0 - rho);
+        return std::max(samplesPerWindow, static_cast<double>(minSamplesPerWindow_)) * periodsSum_ / samples_;
+    }
+
+    /*
+      reset - forgets the collected samples, e.g., to follow the changes of the application
+    */
+    void reset()
+    {
+        const auto metric = metric_;
+        *this = WindowCalibrator(targetRelativeError_, minSamplesPerWindow_);
+        metric_ = metric;
+    }
+
+private:
+    void closeSegment()
+    {
+        if (segmentCount_ > 2)
+        {
+            const double n = segmentCount_;
+            const double mean = segmentSum_ / n;
+            pooledSquares_ += segmentSquares_ - n * mean * mean;
+            pooledDof_ += n - 1.0;
+            // lag-1 covariance around the segment mean
+            pooledLagProducts_ += segmentLagProducts_ - mean * (segmentLagHeads_ + segmentLagTails_) + (n - 1.0) * mean * mean;
+            lagDof_ += n - 2.0;
+        }
+        segmentCount_ = 0;
+        segmentSum_ = segmentSquares_ = 0.0;
+        segmentLagProducts_ = segmentLagHeads_ = segmentLagTails_ = 0.0;
+    }
+
+    static constexpr std::size_t MIN_CALIBRATION_SAMPLES {30};
+    static constexpr double MAX_RHO {0.95};
+
+    double targetRelativeError_;
+    std::size_t minSamplesPerWindow_;
+    TargetMetric metric_ {TargetMetric::MIN_E};
+
+    double segmentCapInWatts_ {0.0};
+    std::size_t segmentCount_ {0};
+    double shift_ {0.0};
+    double previous_ {0.0};
+    double segmentSum_ {0.0};
+    double segmentSquares_ {0.0};
+    double segmentLagProducts_ {0.0};
+    double segmentLagHeads_ {0.0};
+    double segmentLagTails_ {0.0};
+
+    double pooledSquares_ {0.0};
+    double pooledDof_ {0.0};
+    double pooledLagProducts_ {0.0};
+    double lagDof_ {0.0};
+    double periodsSum_ {0.0};
+    std::size_t samples_ {0};
+};
@@ -18,27 +18,24 @@
 
 #include "devices/abstract_device.hpp"
 #include "data_structures/power_and_perf_result.hpp"
+#include "data_structures/power_and_perf_state.hpp"
+#include "sampler.hpp"
 #include "trigger.hpp"
 
-using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
-
-struct PowerAndPerfState
-{
-    PowerAndPerfState() = delete;
-    PowerAndPerfState(double pow, unsigned long long ker, TimePoint t) :
-        power_(pow), kernelsCount_(ker), time_(t)
-    {
-    }
-    double power_;
-    unsigned long long kernelsCount_;
-    TimePoint time_;
-};
+/*
+  DeviceStateAccumulator - accumulates power, energy and performance of the tuned device
 
+  Optionally it accumulates also the energy of auxiliary devices that are part of the
+  same node but are not tuned, e.g., the CPU packages hosting a GPU application. The
+  auxiliary devices are read one after another right after the tuned device and each
+  sample has a single timestamp, so that the per-device energies sum up to the node
+  energy over the same time intervals (skewed by the duration of the counter reads).
+*/
 class DeviceStateAccumulator
 {
 public:
-    DeviceStateAccumulator(std::shared_ptr<Device>);
-    ~DeviceStateAccumulator() {}
+    DeviceStateAccumulator(std::shared_ptr<Device>, std::vector<std::shared_ptr<Device>> auxiliaryDevices = {});
+    ~DeviceStateAccumulator() { stopBackgroundSampling(); }
 
     /*
       getCurrentPowerAndPerf - needed mostly (only?) for logging purposes
@@ -55,6 +52,25 @@ public:
     */
     double getEnergySinceReset() const;
 
+    /*
+      getPerDeviceEnergySinceReset - energy of each device since last Accumulator reset
+
+      returns the energies of the tuned device (first) followed by auxiliary devices
+      in the order of getDevices().
+    */
+    std::vector<double> getPerDeviceEnergySinceReset() const;
+
+    /*
+      getNodeEnergySinceReset - total energy of all accumulated devices since last reset
+    */
+    double getNodeEnergySinceReset() const;
+
+    /*
+      getDevices - the tuned device followed by the auxiliary devices
+    */
+    std::vector<std::shared_ptr<Device>> getDevices() const;
+    bool hasAuxiliaryDevices() const { return !auxiliaryDevices_.empty(); }
+
     /*
       getTimeSinceReset - is used for the final evaluation of time spent on computations
 
@@ -80,19 +96,47 @@ public:
                     std::chrono::high_resolution_clock::now()  - absoluteStartTime_).count();
     }
 
-    // Temporary disabled
-    // ----------------------------------------------------------------------------------------
-    // std::vector<double> getTotalEnergyVec(Domain d);
+    /*
+      getTotalEnergyVec - per package energy of the given domain since last reset
+
+      returns an empty vector for devices that do not report per package energy.
+    */
+    std::vector<double> getTotalEnergyVec(Domain d);
+
+    /*
+      startBackgroundSampling - moves the device sampling to a dedicated thread
+
+      After this call sample() does not read the device itself but consumes the next
+      sample taken by the sampler thread every periodInMilliSeconds. As the sampler
+      wakes up on absolute deadlines the sampling rate does not drift with the work done
+      by the caller between consecutive sample() calls. Without background sampling
+      sample() reads the device synchronously.
+    */
+    void startBackgroundSampling(int periodInMilliSeconds);
+    void stopBackgroundSampling();
+    /*
+      setSamplingPeriod - changes the background sampling period at run time
+    */
+    void setSamplingPeriod(int periodInMilliSeconds);
+    int getSamplingPeriodInMilliSeconds() const;
+    bool isBackgroundSamplingActive() const { return sampler_ && sampler_->isRunning(); }
 
     DeviceStateAccumulator& sample();
     void resetState();
     double getCurrentPower(Domain d);
     double getPerfCounterSinceReset();
+    void attachPerfCounterToProcess(pid_t pid);
 
 private:
+    PowerAndPerfState readDeviceState();
+
     TimePoint absoluteStartTime_;
     TimePoint timeOfLastReset_;
     std::shared_ptr<Device> device_;
+    std::vector<std::shared_ptr<Device>> auxiliaryDevices_;
     PowerAndPerfState prev_, curr_, next_;
     double totalEnergySinceReset_ {0.0};
+    std::array<double, MAX_AUXILIARY_DEVICES> auxiliaryEnergySinceReset_ {};
+    // declared last so that the sampling thread is stopped before the device is released
+    std::unique_ptr<Sampler> sampler_;
 };
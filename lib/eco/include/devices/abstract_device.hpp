@@ -16,14 +16,20 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <memory>
 #include <set>
+#include <map>
 #include <optional>
+#include <sys/types.h>
 #include <cpucounters.h>
 #include "eco_constants.hpp"
 
+// power limits of multiple domains in micro Watts
+using PowerLimits = std::map<Domain, unsigned long>;
+
 class Device
 {
 public:
@@ -33,9 +39,56 @@ public:
     virtual std::pair<unsigned, unsigned> getMinMaxLimitInWatts() const = 0;
     virtual double getPowerLimitInWatts() const = 0;
     virtual void setPowerLimitInMicroWatts(unsigned long limitInMicroW) = 0;
+    /*
+      setPowerLimitsInMicroWatts - sets limits of multiple power domains at once
+
+      OPTIONAL - by default only the PKG limit is applied with setPowerLimitInMicroWatts(),
+      limits of the domains not supported by the device are ignored.
+    */
+    virtual void setPowerLimitsInMicroWatts(const PowerLimits& limits)
+    {
+        auto pkg = limits.find(Domain::PKG);
+        if (pkg != limits.end())
+        {
+            setPowerLimitInMicroWatts(pkg->second);
+        }
+    }
+    /*
+      getDomainMinMaxLimitInWatts - limits range of the given domain
+
+      OPTIONAL - {0, 0} stands for the domain that cannot be limited. By default only
+      the PKG domain is supported, with the range of getMinMaxLimitInWatts().
+    */
+    virtual std::pair<unsigned, unsigned> getDomainMinMaxLimitInWatts(Domain d) const
+    {
+        return d == Domain::PKG ? getMinMaxLimitInWatts() : std::make_pair(0u, 0u);
+    }
     virtual void reset() = 0;
     virtual unsigned long long int getPerfCounter() const = 0;
     virtual double getCurrentPowerInWatts(std::optional<Domain>) const = 0;
+    /*
+      getEnergyCounterInJoules - cumulative energy consumed by the device
+
+      returns the value of a monotonic energy counter as of the last triggerPowerApiSample()
+      call. The counter is never reset (also not by reset()), so only the difference
+      between two readings is meaningful. Energy computed from counter deltas is exact
+      regardless of the sampling period, contrary to integrating the sampled power.
+    */
+    virtual double getEnergyCounterInJoules() const = 0;
+    /*
+      getPerPackageEnergyInJoules - energy of the given domain per package since reset()
+
+      OPTIONAL - only devices made of multiple packages (e.g., multi-socket Intel CPU)
+      provide it. Returns an empty vector by default.
+    */
+    virtual std::vector<double> getPerPackageEnergyInJoules(Domain) const { return {}; }
+    /*
+      getMemoryEnergyCounterInJoules - cumulative energy of the memory (e.g., DRAM domain)
+
+      OPTIONAL - for devices measuring the memory energy separately from
+      getEnergyCounterInJoules(). Follows the same rules, returns 0.0 by default.
+    */
+    virtual double getMemoryEnergyCounterInJoules() const { return 0.0; }
     virtual void restoreDefaultLimits() = 0;
     virtual std::string getDeviceTypeString() const = 0;
     /*
@@ -48,6 +101,37 @@ public:
       may be just left empty. For Intel it needs to have Rapl::sample() method call.
     */
     virtual void triggerPowerApiSample() = 0;
+    /*
+      attachPerfCounterToProcess - used to limit the performance counting to the tuned app
+
+      OPTIONAL - called by Eco with the PID of the forked application before it executes
+      the workload. Devices counting the performance of the whole device (e.g., kernels
+      count on GPU) may leave the default empty implementation.
+    */
+    virtual void attachPerfCounterToProcess(pid_t) {}
+    /*
+      setAlignedSampling - used to synchronize samples with the energy counter updates
+
+      OPTIONAL - devices with coarse, periodically updated energy counters (e.g., Intel
+      RAPL) may wait for the counter update in triggerPowerApiSample() to reduce the
+      quantization error of short measurement windows. Ignored by default.
+    */
+    virtual void setAlignedSampling(bool) {}
+    /*
+      getLastPowerApiSampleTime - timestamp of the energy readings of the last triggerPowerApiSample()
+
+      OPTIONAL - devices which know better than the caller when their counters were read
+      (e.g., at the update edge with aligned sampling) return it, so that the device state
+      is timestamped with it. By default the caller's time of the request is used.
+    */
+    virtual std::optional<std::chrono::high_resolution_clock::time_point> getLastPowerApiSampleTime() const { return std::nullopt; }
+    /*
+      getIdlePowerInWatts - average power of the idle device in the limited domain
+
+      OPTIONAL - used by model based tuning as the power floor, 0.0 means unknown
+      and lets the model estimate it from the measurements.
+    */
+    virtual double getIdlePowerInWatts() const { return 0.0; }
 
 private:
 };
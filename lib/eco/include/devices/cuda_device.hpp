@@ -67,8 +67,15 @@ class CudaDevice : public Device
     std::pair<unsigned, unsigned> getMinMaxLimitInWatts() const override;
     void reset() override;
     double getCurrentPowerInWatts(std::optional<Domain> = std::nullopt) const override;
+    double getEnergyCounterInJoules() const override;
     unsigned long long int getPerfCounter() const;
-    void triggerPowerApiSample() override {}; // empty method since, NVIDIA GPU does not need to explicit trigger API sampling
+    /*
+      triggerPowerApiSample - NVIDIA GPU does not need to explicit trigger API sampling
+
+      It is used only on GPUs without the total energy counter in NVML (pre-Volta)
+      where the energy counter is emulated by integrating the power readings.
+    */
+    void triggerPowerApiSample() override;
     void restoreDefaultLimits() override;
     std::string getDeviceTypeString() const override { return "gpu"; };
 
@@ -80,4 +87,9 @@ class CudaDevice : public Device
     int deviceID_;
     std::vector<nvmlDevice_t> deviceHandles_;
     double defaultPowerLimitInWatts_;
+    bool hasTotalEnergyCounter_ {false};
+    double integratedEnergyInJoules_ {0.0};
+    mutable double lastEnergyCounterInJoules_ {0.0};
+    double lastPowerInWatts_ {0.0};
+    std::chrono::time_point<std::chrono::high_resolution_clock> timeOfLastPowerSample_;
 };
@@ -21,8 +21,13 @@
 #include <memory>
 #include <set>
 #include <optional>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <cpucounters.h>
 #include "power_interface/Rapl.hpp"
+#include "power_interface/rapl_series_store.hpp"
+#include "perf_counter_interfaces/perf_event_counter.hpp"
 #include "devices/abstract_device.hpp"
 
 struct RaplDirs
@@ -47,19 +52,39 @@ struct RaplDefaults
     std::shared_ptr<SubdomainInfo> defaultConstrDRAM_;
 };
 
+enum class PerfCounterBackend
+{
+    PERF_EVENT, // per-process counters of the attached application (perf_event_open)
+    PCM         // system-wide counters of all the cores (Intel PCM)
+};
+
 class IntelDevice : public Device
 {
 public:
-    IntelDevice();
-    virtual ~IntelDevice() = default;
+    IntelDevice(PerfCounterBackend = PerfCounterBackend::PERF_EVENT);
+    virtual ~IntelDevice();
 
     double getPowerLimitInWatts() const override;
     void setPowerLimitInMicroWatts(unsigned long limitInMicroW) override;
+    void setPowerLimitsInMicroWatts(const PowerLimits& limits) override;
+    std::pair<unsigned, unsigned> getDomainMinMaxLimitInWatts(Domain) const override;
     std::string getName() const override;
     void reset() override;
     double getCurrentPowerInWatts(std::optional<Domain> = std::nullopt) const override;
+    double getEnergyCounterInJoules() const override;
+    double getMemoryEnergyCounterInJoules() const override;
+    std::vector<double> getPerPackageEnergyInJoules(Domain) const override;
+    const RaplSeriesStore& getRaplSeries() const { return raplSeries_; }
     void triggerPowerApiSample() override;
     unsigned long long int getPerfCounter() const override;
+    void attachPerfCounterToProcess(pid_t) override;
+    /*
+      setAlignedSampling - the packages wait for their counter updates one after another,
+      so a sample may take up to ~1 ms per package (while the other RAPL users are blocked)
+    */
+    void setAlignedSampling(bool) override;
+    std::optional<std::chrono::high_resolution_clock::time_point> getLastPowerApiSampleTime() const override { return lastSampleTime_; }
+    double getIdlePowerInWatts() const override;
 
     /*
       getMinMaxLimitInWatts - used to determine the available power limits range
@@ -86,21 +111,43 @@ private:
     void initPerformanceCounters();
     std::string mapCpuFamilyName(int model) const;
     void setLongTimeWindow(int); // might be useless
+    void setDomainLimitInMicroWatts(Domain, unsigned long);
     void initRaplObjectsForEachPKG();
     void checkIdlePowerConsumption();
+    /*
+      startWrapGuard - starts the thread ticking RAPL objects often enough to never miss
+      a raw counter wrap, so triggerPowerApiSample() may be called at any period
+    */
+    void startWrapGuard();
+    void stopWrapGuard();
 
     int totalPackages_ {0};
     int totalCores_ {0};
     int model_ {-1};
-    pcm::PCM* pcm_;
+    PerfCounterBackend perfCounterBackend_;
+    pcm::PCM* pcm_ {nullptr};
+    std::unique_ptr<PerfEventCounter> perfEventCounter_;
+    uint64_t instructionsAtReset_ {0};
     AvailableRaplPowerDomains devicePowerProfile_;
     RaplDirs raplDirs_;
     RaplDefaults raplDefaultCaps_;
     double currentPowerLimitInWatts_;
-    double idlePowerConsumption_;
+    double idlePowerConsumption_ {0.0};
     const std::string defaultLimitsFile_ {"./default_limits_dump.txt"};
+    // DRAM limits below this fraction of the default one are not explored
+    static constexpr double DRAM_MIN_LIMIT_FRACTION {0.25};
     std::vector<int> pkgToFirstCoreMap_;
     std::vector<Rapl> raplVec_;
+    RaplSeriesStore raplSeries_;
+    std::vector<std::array<double, NUM_RAPL_DOMAINS>> lastEnergyIncrements_;
+    bool alignedSampling_ {false};
+    std::chrono::high_resolution_clock::time_point lastSampleTime_ {};
     pcm::SystemCounterState sysBeforeState_;
     std::vector<pcm::CoreCounterState> beforeState_;
+    // serializes wrap guard ticks with sampling and resetting of raplVec_
+    std::mutex raplMutex_;
+    std::condition_variable wrapGuardCv_;
+    bool stopWrapGuard_ {false};
+    double wrapGuardPeriodInSeconds_ {0.0};
+    std::thread wrapGuardThread_;
 };
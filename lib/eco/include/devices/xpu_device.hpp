@@ -76,6 +76,7 @@ public:
     std::pair<unsigned, unsigned> getMinMaxLimitInWatts() const override;
     void                          reset() override;
     double                        getCurrentPowerInWatts(std::optional<Domain> = std::nullopt) const override;
+    double                        getEnergyCounterInJoules() const override;
     unsigned long long int        getPerfCounter() const;
     void                          triggerPowerApiSample() override;
     void                          restoreDefaultLimits() override;
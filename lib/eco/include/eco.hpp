@@ -28,14 +28,23 @@
 //----------------------------------------------------------------------------------
 #include "algorithms/linear_search.hpp"
 #include "algorithms/golden_section_search.hpp"
+#include "algorithms/bayesian_optimization_search.hpp"
+#include "algorithms/noise_aware_golden_section_search.hpp"
+#include "algorithms/perturb_and_observe.hpp"
+#include "algorithms/pkg_dram_coordinate_descent.hpp"
+#include "algorithms/local_retuning_search.hpp"
+#include "algorithms/model_based_search.hpp"
+#include "algorithms/thompson_sampling_controller.hpp"
 #include "data_structures/power_and_perf_result.hpp"
 #include "eco_constants.hpp"
 #include "data_structures/final_power_and_perf_result.hpp"
 #include "params_config.hpp"
 #include "data_structures/data_filter.hpp"
+#include "data_structures/window_calibrator.hpp"
 #include "logging/both_stream.hpp"
 #include "logging/log.hpp"
 #include "trigger.hpp"
+#include "tuning_cache.hpp"
 
 
 template <class F>
@@ -81,7 +90,11 @@ class Eco
     void staticEnergyProfiler(char* const* argv, int argc);
 
     Eco() = delete;
-    Eco(std::shared_ptr<Device>);
+    /*
+      Eco - tunes the first device, energy of auxiliary devices (e.g., host CPU of
+      a GPU job) is only accounted for and reported together with the node energy.
+    */
+    Eco(std::shared_ptr<Device>, std::vector<std::shared_ptr<Device>> auxiliaryDevices = {});
     virtual ~Eco();
     std::string getResultFileName() const { return logger_.getResultFileName(); }
     void logToResultFile(std::stringstream& ss) { logger_.logToResultFile(ss); }
@@ -100,6 +113,9 @@ class Eco
     DeviceStateAccumulator devStateGlobal_;
     std::vector<FinalPowerAndPerfResult> fullAppRunResultsContainer_;
     Logger logger_;
+    int tuningWindowInMicroSeconds_;
+    double applicationPeriodInMicroSeconds_ {0.0};
+    WindowCalibrator windowCalibrator_;
 
     WatchdogStatus defaultWatchdog;
     void modifyWatchdog(WatchdogStatus);
@@ -110,7 +126,36 @@ class Eco
     PowAndPerfResult checkPowerAndPerformance(int);
     void reportResult(double = 0.0, double = 0.0);
     void waitForTuningTrigger(int&, int);
-    void execPhase(int, int&, int, PowAndPerfResult&);
+    /*
+      execPhase - runs the application with the tuned cap, with execPhaseExplorationFraction
+      set the caps around it are explored and the returned cap is the one exploited at the end,
+      the reason for leaving the phase is stored in the last argument
+    */
+    int execPhase(int, int&, int, PowAndPerfResult&, TargetMetric, ExecPhaseExit&);
+    void detectApplicationPeriod();
+    /*
+      updateTuningWindow - sets the tuning window to msTestPhasePeriod or, with autoTuningWindow,
+      to the window calibrated from the samples since the last update, then rounds it to
+      whole application periods if a period shorter than the window was detected
+    */
+    void updateTuningWindow();
+    /*
+      onlineTuningPhase - execution phase continuously tuning the cap by perturb and observe
+
+      runs until the app ends or an external trigger arrives, returns the last applied cap
+      in micro Watts
+    */
+    int onlineTuningPhase(int&, int, PowAndPerfResult&, TargetMetric);
+    void setFastSampling();
+    void adaptSamplingPeriod();
+    /*
+      verifyCachedPowerCap - applies the cached cap for a single tuning window
+
+      returns the cap in micro Watts if the measured metric is not worse than the cached
+      one by more than tuningCacheTolerance, -1 if there is no entry or it is rejected
+    */
+    int verifyCachedPowerCap(const std::optional<TuningCacheEntry>&, PowAndPerfResult&, TargetMetric);
+    pid_t startMonitoredApp(char* const*, int&);
     int mainAppProcess(char* const*, int&);
     int& adjustHighPowLimit(PowAndPerfResult, int&);
 
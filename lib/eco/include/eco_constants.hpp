@@ -31,9 +31,21 @@ enum class TargetMetric {
     MIN_M_PLUS
 };
 
+enum class ExecPhaseExit {
+    APPLICATION_FINISHED,
+    PERIODIC_REPETITION,
+    PHASE_CHANGE,
+    EXTERNAL_TRIGGER
+};
+
 enum class SearchType {
     LINEAR_SEARCH,
-    GOLDEN_SECTION_SEARCH
+    GOLDEN_SECTION_SEARCH,
+    BAYESIAN_OPTIMIZATION,
+    NOISE_AWARE_GOLDEN_SECTION_SEARCH,
+    ONLINE_PERTURB_AND_OBSERVE,
+    PKG_DRAM_COORDINATE_DESCENT,
+    MODEL_BASED_SEARCH
 };
 
 template <class Stream>
@@ -64,6 +76,21 @@ Stream& operator<<(Stream& os, const SearchType& st) {
         case SearchType::GOLDEN_SECTION_SEARCH :
             os << "Golden Section Search";
             break;
+        case SearchType::BAYESIAN_OPTIMIZATION :
+            os << "Bayesian Optimization";
+            break;
+        case SearchType::NOISE_AWARE_GOLDEN_SECTION_SEARCH :
+            os << "Noise-aware Golden Section Search";
+            break;
+        case SearchType::ONLINE_PERTURB_AND_OBSERVE :
+            os << "Online Perturb and Observe";
+            break;
+        case SearchType::PKG_DRAM_COORDINATE_DESCENT :
+            os << "PKG+DRAM Coordinate Descent";
+            break;
+        case SearchType::MODEL_BASED_SEARCH :
+            os << "Model-based Search";
+            break;
         default :
             os << "Undefined search";
             break;
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "data_structures/power_and_perf_result.hpp"
+#include <vector>
 
 static inline
 std::string logCurrentResultLine(
@@ -111,6 +112,24 @@ class Logger
     void logPowerLogLine(DeviceStateAccumulator& deviceState, PowAndPerfResult current, const std::optional<PowAndPerfResult> reference = std::nullopt)
     {
         *power_bout_  << logCurrentPowerLogtLine(deviceState.getTimeSinceObjectCreation(), current, reference);
+        if (recordTuningWindows_ && reference.has_value())
+        {
+            tuningWindows_.push_back(current);
+        }
+    }
+    /*
+      startRecordingTuningWindows - from now on keeps each result logged with the reference,
+      i.e., each tuning window measured by the search algorithms
+    */
+    void startRecordingTuningWindows()
+    {
+        tuningWindows_.clear();
+        recordTuningWindows_ = true;
+    }
+    std::vector<PowAndPerfResult> stopRecordingTuningWindows()
+    {
+        recordTuningWindows_ = false;
+        return std::move(tuningWindows_);
     }
     void logToResultFile(std::stringstream& ss)
     {
@@ -141,6 +160,8 @@ class Logger
     std::ofstream resultFile_;
     std::unique_ptr<BothStream> power_bout_;
     std::unique_ptr<BothStream> result_bout_;
+    bool recordTuningWindows_ {false};
+    std::vector<PowAndPerfResult> tuningWindows_;
 
     std::string generateUniqueDir(std::string prefix = "")
     {
@@ -38,6 +38,27 @@ public:
     int repeatTuningPeriodInSec_ {10}; // seconds
     double k_ {1.0};
     bool doWaitPhase_ {true};
+    bool adaptiveSampling_ {false}; // slow down sampling during stable execution phase
+    int msPauseMax_ {1600}; // max sampling time with adaptive sampling
+    double samplingBackoffFactor_ {2.0};
+    bool alignedSampling_ {false}; // synchronize samples with energy counter updates
+    std::string tuningCacheFile_ {""}; // empty disables the tuning cache
+    double tuningCacheTolerance_ {0.03}; // accepted relative cost increase of the cached cap
+    bool autoTuningWindow_ {false}; // calibrate the tuning window from the measured variance
+    double expectedMetricGap_ {0.05}; // relative metric difference the tuning windows have to resolve
+    double tuningWindowErrorFraction_ {0.25}; // max relative standard error as a fraction of the gap
+    int msTestPhasePeriodMax_ {10000}; // max calibrated tuning window
+    bool equalWorkWindows_ {false}; // tuning windows end after the same work instead of the same time
+    double equalWorkMaxWindowStretch_ {2.0}; // max equal work window length relative to msTestPhasePeriod
+    bool earlyTermination_ {false}; // end LS/GSS windows of candidates dominated by the incumbent
+    double earlyTerminationMargin_ {0.05}; // relative cost increase tested by the sequential test
+    bool localRetuning_ {false}; // repeated tuning searches around the previous optimum only
+    double retuningCacheHalfLifeInSec_ {300.0}; // age after which cached measurements count half
+    double execPhaseExplorationFraction_ {0.0}; // share of Execution Phase spent exploring the neighbouring caps
+    bool periodicityDetection_ {false}; // align tuning windows to the period of the app iterations
+    bool changePointDetection_ {false}; // re-tune when the application behaviour shifts
+    double changePointThreshold_ {8.0}; // CUSUM threshold in standard deviations, lower is more sensitive
+    double changePointCooldownInSec_ {10.0}; // min time between applying a cap and the re-tuning
     void printConfigExplained();
 private:
     void loadConfig();
@@ -0,0 +1,71 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <sys/types.h>
+
+struct PerfEventReading
+{
+    uint64_t instructions_ {0};
+    uint64_t cycles_ {0};
+};
+
+/*
+  PerfEventCounter - per-process hardware counters based on perf_event_open
+
+  Counts instructions retired and core cycles of the attached process and (thanks to
+  the inherit flag) all the threads and processes it creates after attaching. Thus only
+  the monitored application is credited, not the tuning tool itself nor other processes
+  running on the node.
+
+  When attached with enableOnExec the counters start counting at the execve() of the
+  attached process, which allows attaching to a forked child before it runs the workload.
+
+  Counters are read with a single group read when the kernel allows inherited groups,
+  otherwise each counter is read separately. Values are scaled by the enabled/running
+  time ratio in case of counter multiplexing.
+*/
+class PerfEventCounter
+{
+public:
+    PerfEventCounter() = default;
+    PerfEventCounter(const PerfEventCounter&) = delete;
+    PerfEventCounter& operator=(const PerfEventCounter&) = delete;
+    ~PerfEventCounter();
+
+    /*
+      attach - opens the counters for the given process
+
+      returns false if the counters cannot be opened (e.g., due to perf_event_paranoid
+      settings or missing PMU support), in such case no counters are attached.
+    */
+    bool attach(pid_t pid, bool enableOnExec = true);
+    void detach();
+    bool isAttached() const { return !fds_.empty(); }
+    bool isGroupRead() const { return isGroupRead_; }
+    PerfEventReading read() const;
+
+private:
+    int openCounter(uint64_t config, pid_t pid, int groupFd, bool enableOnExec, bool asGroup);
+
+    // instructions first, then cycles; with group read fds_[0] is the group leader
+    std::vector<int> fds_;
+    bool isGroupRead_ {false};
+    bool excludeKernel_ {false};
+};
@@ -19,9 +19,14 @@
 #include "eco_constants.hpp"
 #include "msr_offsets.hpp"
 #include "msr.hpp"
+#include "energy_reader.hpp"
+#include "extended_energy_counter.hpp"
 
+#include <array>
 #include <chrono>
+#include <memory>
 #include <set>
+#include <vector>
 
 #define MAX_PACKAGES	16
 
@@ -55,15 +60,18 @@ public:
     void rotateStates();
 	void storeNextState(RaplState& rs);
 	void reset();
+	// counter value at which each domain wraps, 0 for the full 64-bit range
+	void setWrapRanges(const std::array<uint64_t, 4>& ranges) { wrapRanges_ = ranges; }
 	RaplState getCurrentEnergyIncrement() const;
 	RaplState getPreviousEnergyIncrement() const;
 	double getCurrentTimeIncrement() const;
 	double getPreviousTimeIncrement() const;
 	double getTotalTime(TimePoint startTime) const;
 private:
-    uint64_t energyDelta(uint64_t before, uint64_t after) const;
+    uint64_t energyDelta(uint64_t before, uint64_t after, Domain d) const;
 	double timeDelta(const TimePoint&,const TimePoint&) const;
 	RaplState next_, current_, previous_;
+	std::array<uint64_t, 4> wrapRanges_ {uint64_t(1) << 32, uint64_t(1) << 32, uint64_t(1) << 32, uint64_t(1) << 32};
 };
 
 class Rapl
@@ -76,17 +84,59 @@ private:
 	// void read_cpu_info(int, int); // TODO: is it needed?
 	double calculate_power(uint64_t energyIncrement, double time_delta, double units) const;
 	void initializeRaplForPowerReadingAndCapping();
+	void initializeEnergyReader();
+	TimePoint waitForCounterUpdate();
 
 	AvailableRaplPowerDomains availableDomains_;
 	int cpuCore_;
 	RaplState totalResultSinceLastReset_;
+	// accumulated since the object creation, not cleared by reset()
+	RaplState totalResultSinceCreation_;
     RaplStateSequence rss_;
+    // MSR file of the package is opened once and kept open for the object lifetime
+    // so that sampling costs only the preads of the energy status registers.
+    // It is null when MSR is not accessible, then energy is read by other backend.
+    std::unique_ptr<MSR> msr_;
+    std::string powercapZoneDir_;
+    // declared after msr_ as the MSR backend refers to it
+    std::unique_ptr<EnergyReader> energyReader_;
+    std::vector<Domain> sampledDomains_;
+    std::array<uint64_t, 4> energyStatus_ {0, 0, 0, 0};
+    // raw counters extended to 64 bits, so rss_ never sees a wrap
+    std::array<ExtendedEnergyCounter, 4> extendedCounters_;
+    bool alignedSampling_ {false};
+    TimePoint lastSampleTime_ {};
 
 public:
-	Rapl(int, AvailableRaplPowerDomains);
-	~Rapl() {}
+	/*
+	  Rapl - RAPL interface of the package the given core belongs to
+
+	  Energy counters are read by the first available backend (MSR, powercap sysfs
+	  zone given by powercapZoneDir, perf power PMU).
+	*/
+	Rapl(int, AvailableRaplPowerDomains, std::string powercapZoneDir = "");
+	Rapl(Rapl&&) = default;
+	~Rapl() = default;
 	void reset();
 	void sample();
+	/*
+	  tick - reads the raw counters only to keep the 64-bit extension up to date
+
+	  Has to be called (directly or by sample()) more often than getWrapPeriodInSeconds().
+	  Not thread safe against sample(), the caller has to serialize them.
+	*/
+	void tick();
+	/*
+	  setAlignedSampling - when on, sample() waits for the next update of the PKG counter
+	  (about every 1 ms) and timestamps the sample at the update edge, removing the phase
+	  error between the read and the counter update at the cost of up to ~1 ms of polling
+	*/
+	void setAlignedSampling(bool on) { alignedSampling_ = on; }
+	bool isAlignedSampling() const { return alignedSampling_; }
+	// timestamp of the last sample(), at the update edge with aligned sampling
+	TimePoint getLastSampleTime() const { return lastSampleTime_; }
+	// shortest time in which any of the sampled raw counters may wrap at the given power
+	double getWrapPeriodInSeconds(double maxPowerInWatts) const;
 
 	double pkg_current_power() const;
 	double pp0_current_power() const;
@@ -104,10 +154,15 @@ public:
 	double pp0_total_energy() const;
 	double pp1_total_energy() const;
 	double dram_total_energy() const;
+	double pkg_energy_counter() const;
+	double dram_energy_counter() const;
+	// energy consumed between the two last samples in Joules, indexed by Domain
+	void getLastEnergyIncrementInJoules(std::array<double, 4>& result) const;
 	EnergyCrossDomains getTotalEnergy() const;
 	PowerCrossDomains getAveragePower() const;
 	PowerCrossDomains getCurrentPower() const;
 
+	std::string getEnergyReaderName() const { return energyReader_->getName(); }
 	double get_total_time() const;
 	double current_time();
 };
@@ -0,0 +1,134 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "eco_constants.hpp"
+#include "msr.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+  EnergyReader - source of the raw RAPL energy counters used by Rapl::sample()
+
+  Each implementation reads the cumulative energy counters of a single CPU package.
+  Raw values are expressed in getEnergyUnitInJoules() units and wrap around at
+  getWrapRange() (0 stands for the full 64-bit range, i.e., no wrap in practice).
+*/
+class EnergyReader
+{
+public:
+    virtual ~EnergyReader() = default;
+    virtual std::string getName() const = 0;
+    virtual bool isDomainAvailable(Domain) const = 0;
+    /*
+      read - reads counters of all the given domains in a single pass and stores them
+      under the domain index, unavailable domains are read as 0
+    */
+    virtual void read(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result) = 0;
+    virtual double getEnergyUnitInJoules(Domain) const = 0;
+    virtual uint64_t getWrapRange(Domain) const = 0;
+};
+
+/*
+  MsrEnergyReader - reads MSR_*_ENERGY_STATUS registers, requires root and msr module
+*/
+class MsrEnergyReader : public EnergyReader
+{
+public:
+    MsrEnergyReader(MSR& msr, double energyUnits, double dramEnergyUnits);
+    std::string getName() const override { return "msr"; }
+    bool isDomainAvailable(Domain) const override { return true; }
+    void read(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result) override;
+    double getEnergyUnitInJoules(Domain d) const override { return d == Domain::DRAM ? dramEnergyUnits_ : energyUnits_; }
+    uint64_t getWrapRange(Domain) const override { return uint64_t(1) << 32; }
+
+private:
+    MSR& msr_;
+    double energyUnits_;
+    double dramEnergyUnits_;
+};
+
+/*
+  PowercapEnergyReader - reads energy_uj files of the powercap intel-rapl zone
+
+  The package zone (e.g., /sys/class/powercap/intel-rapl:0/) is read directly and its
+  subzones are mapped to domains basing on their "name" files (core - PP0, uncore - PP1,
+  dram - DRAM). All energy_uj files are opened once and read with pread, wrap range of
+  each domain is read from its max_energy_range_uj file. Readable by unprivileged users
+  on kernels/distributions not restricting energy_uj access.
+*/
+class PowercapEnergyReader : public EnergyReader
+{
+public:
+    explicit PowercapEnergyReader(const std::string& packageZoneDir);
+    PowercapEnergyReader(const PowercapEnergyReader&) = delete;
+    PowercapEnergyReader& operator=(const PowercapEnergyReader&) = delete;
+    ~PowercapEnergyReader();
+    std::string getName() const override { return "powercap"; }
+    bool isDomainAvailable(Domain d) const override { return fds_[d] >= 0; }
+    void read(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result) override;
+    double getEnergyUnitInJoules(Domain) const override { return 1e-6; }
+    uint64_t getWrapRange(Domain d) const override { return wrapRanges_[d]; }
+
+private:
+    void openZone(const std::string& zoneDir, Domain d);
+
+    std::array<int, 4> fds_ {-1, -1, -1, -1};
+    std::array<uint64_t, 4> wrapRanges_ {0, 0, 0, 0};
+};
+
+/*
+  PerfEnergyReader - reads energy-* events of the perf "power" PMU
+
+  Events (energy-pkg, energy-cores, energy-gpu, energy-ram) are opened system-wide for
+  the given CPU of the package. The kernel extends the counters to 64 bits and each event
+  has its own scale. Requires perf_event_paranoid <= 0 or CAP_PERFMON but not the msr module.
+*/
+class PerfEnergyReader : public EnergyReader
+{
+public:
+    PerfEnergyReader(int cpu, const std::string& pmuDir = "/sys/bus/event_source/devices/power/");
+    PerfEnergyReader(const PerfEnergyReader&) = delete;
+    PerfEnergyReader& operator=(const PerfEnergyReader&) = delete;
+    ~PerfEnergyReader();
+    std::string getName() const override { return "perf"; }
+    bool isDomainAvailable(Domain d) const override { return fds_[d] >= 0; }
+    void read(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result) override;
+    double getEnergyUnitInJoules(Domain d) const override { return scales_[d]; }
+    uint64_t getWrapRange(Domain) const override { return 0; }
+
+private:
+    std::array<int, 4> fds_ {-1, -1, -1, -1};
+    std::array<double, 4> scales_ {0.0, 0.0, 0.0, 0.0};
+};
+
+/*
+  createEnergyReader - selects the first available backend: MSR, powercap, perf
+
+  msr may be nullptr when /dev/cpu/N/msr is not accessible. Throws std::runtime_error
+  when none of the backends can be used.
+*/
+std::unique_ptr<EnergyReader> createEnergyReader(
+    int cpu,
+    const std::string& powercapPackageZoneDir,
+    MSR* msr,
+    double msrEnergyUnits,
+    double msrDramEnergyUnits);
@@ -0,0 +1,58 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+/*
+  ExtendedEnergyCounter - extends a wrapping raw energy counter to 64 bits
+
+  The raw counter wraps to 0 after reaching wrapRange - 1 (wrapRange of 0 stands for
+  the full 64-bit range). update() must be called at least once per wrap period as
+  only a single wrap between two consecutive updates can be detected.
+*/
+class ExtendedEnergyCounter
+{
+public:
+    void setWrapRange(uint64_t wrapRange) { wrapRange_ = wrapRange; }
+    uint64_t getWrapRange() const { return wrapRange_; }
+
+    /*
+      update - feeds the current raw counter value and returns the extended one
+
+      The first update only sets the reference point and does not add energy.
+    */
+    uint64_t update(uint64_t raw)
+    {
+        if (initialized_)
+        {
+            // unsigned arithmetic handles the full 64-bit range
+            value_ += raw >= lastRaw_ ? raw - lastRaw_ : raw + (wrapRange_ - lastRaw_);
+        }
+        lastRaw_ = raw;
+        initialized_ = true;
+        return value_;
+    }
+
+    uint64_t getValue() const { return value_; }
+
+private:
+    uint64_t wrapRange_ {uint64_t(1) << 32};
+    uint64_t lastRaw_ {0};
+    uint64_t value_ {0};
+    bool initialized_ {false};
+};
@@ -18,6 +18,9 @@
 
 #include "eco_constants.hpp"
 
+#include <array>
+#include <vector>
+
 static constexpr int UNDEFINED_FD {-1};
 
 enum class Quantity {
@@ -36,8 +39,24 @@ class MSR {
 public:
     MSR() = delete;
     MSR(int core);
+    MSR(const MSR&) = delete;
+    MSR& operator=(const MSR&) = delete;
     ~MSR();
+    /*
+      isAccessible - checks if MSR file of the core can be opened for reading and writing
+
+      contrary to the constructor it does not terminate the application on failure.
+    */
+    static bool isAccessible(int core);
     uint64_t getEnergyStatus(Domain domain = Domain::PKG);
+    /*
+      getEnergyStatus - batched variant used by Rapl::sample()
+
+      reads the energy status registers of all the given domains in a single pass
+      over the already opened MSR file and stores the masked values under the
+      domain index in the result array. Domains not listed are left untouched.
+    */
+    void getEnergyStatus(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result);
     double getUnits(Quantity q);
     double getFixedDramUnitsValue(); // some server CPUs use different Power Unit for DRAM
     PowerInfo getPowerInfoForPKG();
@@ -0,0 +1,85 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "eco_constants.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+static constexpr std::size_t NUM_RAPL_DOMAINS {4};
+
+/*
+  RaplSeriesStore - structure-of-arrays time series of RAPL energy increments
+
+  Each (package, domain) pair has its own contiguous column of energy increments
+  in Joules and all the columns share a single timestamp column, i.e., one sampling
+  pass over all the packages appends one row. Columns are rings of fixed capacity so
+  the memory is allocated once. Totals since reset and the current power are kept
+  per column and updated on append so the queries are O(1) per package and do not
+  allocate.
+*/
+class RaplSeriesStore
+{
+public:
+    RaplSeriesStore() = default;
+    RaplSeriesStore(std::size_t numPackages, std::size_t capacity = 4096);
+
+    /*
+      appendSample - appends one row; energyIncrements holds NUM_RAPL_DOMAINS
+      increments in Joules for each package, package after package
+    */
+    void appendSample(TimePoint timestamp, const std::vector<std::array<double, NUM_RAPL_DOMAINS>>& energyIncrements);
+
+    /*
+      reset - clears the history and totals, the last power readings are kept
+    */
+    void reset();
+
+    std::size_t getNumPackages() const { return numPackages_; }
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+
+    double getTotalEnergy(std::size_t pkg, Domain d) const { return totalEnergy_[columnIndex(pkg, d)]; }
+    double getTotalEnergy(Domain d) const;
+    std::vector<double> getTotalEnergyPerPackage(Domain d) const;
+    double getCurrentPower(std::size_t pkg, Domain d) const { return currentPower_[columnIndex(pkg, d)]; }
+    double getCurrentPower(Domain d) const;
+
+    // i-th stored row, 0 is the oldest one still in the ring
+    double getEnergyIncrementAt(std::size_t pkg, Domain d, std::size_t i) const;
+    TimePoint getTimestampAt(std::size_t i) const;
+
+private:
+    std::size_t columnIndex(std::size_t pkg, Domain d) const { return pkg * NUM_RAPL_DOMAINS + d; }
+    std::size_t rowIndex(std::size_t i) const { return (head_ + capacity_ - size_ + i) % capacity_; }
+
+    std::size_t numPackages_ {0};
+    std::size_t capacity_ {0};
+    std::size_t head_ {0};
+    std::size_t size_ {0};
+    std::vector<std::vector<double>> energyColumns_;
+    std::vector<TimePoint> timestamps_;
+    std::vector<double> totalEnergy_;
+    std::vector<double> currentPower_;
+    TimePoint lastTimestamp_ {};
+    bool hasLastTimestamp_ {false};
+};
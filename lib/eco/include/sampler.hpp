@@ -0,0 +1,101 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "data_structures/power_and_perf_state.hpp"
+#include "data_structures/spsc_ring.hpp"
+
+/*
+  Sampler - dedicated thread taking device state samples at a fixed rate
+
+  The sampling thread wakes up on absolute CLOCK_MONOTONIC deadlines
+  (clock_nanosleep with TIMER_ABSTIME), so the time spent on reading the device,
+  logging or waiting for the child process in the consumer thread does not add
+  to the sampling period. Each sample is pushed to a lock-free SPSC ring from which
+  the consumer (DeviceStateAccumulator) pops it with waitForNextSample().
+
+  The probe is always called with the probe mutex held, so any other access to the
+  sampled device that modifies its state (e.g., Device::reset()) shall be wrapped
+  in runExclusively().
+*/
+class Sampler
+{
+public:
+    using Probe = std::function<PowerAndPerfState()>;
+
+    Sampler() = delete;
+    Sampler(Probe probe, int periodInMicroSeconds, bool realTimePriority = true, std::size_t ringCapacity = 1024);
+    Sampler(const Sampler&) = delete;
+    Sampler& operator=(const Sampler&) = delete;
+    ~Sampler();
+
+    void start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    /*
+      waitForNextSample - blocks the consumer until the next sample is available
+
+      When the sampling thread is stopped the probe is called directly.
+    */
+    PowerAndPerfState waitForNextSample();
+
+    /*
+      dropPendingSamples - discards all the samples not consumed yet
+
+      Must be called from the consumer thread.
+    */
+    void dropPendingSamples();
+
+    template <class F>
+    void runExclusively(F&& fun)
+    {
+        std::lock_guard<std::mutex> lock(probeMutex_);
+        fun();
+    }
+
+    /*
+      setPeriodInMicroSeconds - changes the sampling period at run time
+
+      The new period applies already to the deadline being waited for, i.e., the next
+      sample is taken one new period after the previous one (or immediately if that
+      moment has already passed).
+    */
+    void setPeriodInMicroSeconds(int periodInMicroSeconds) { periodInMicroSeconds_.store(periodInMicroSeconds); }
+    int getPeriodInMicroSeconds() const { return periodInMicroSeconds_.load(); }
+    unsigned long long getOverrunsCount() const { return overruns_.load(); }
+    unsigned long long getDroppedSamplesCount() const { return droppedSamples_.load(); }
+
+private:
+    void samplingLoop();
+    void trySetRealTimePriority();
+
+    Probe probe_;
+    std::atomic<int> periodInMicroSeconds_;
+    bool realTimePriority_;
+    SpscRing<PowerAndPerfState> ring_;
+    std::mutex probeMutex_;
+    std::atomic<bool> running_ {false};
+    std::atomic<unsigned long long> overruns_ {0};
+    std::atomic<unsigned long long> droppedSamples_ {0};
+    std::thread thread_;
+};
@@ -17,8 +17,14 @@
 #pragma once
 
 #include "data_structures/data_filter.hpp"
+#include "data_structures/cusum_detector.hpp"
+#include "data_structures/periodicity_detector.hpp"
+#include "data_structures/stability_detector.hpp"
 #include "params_config.hpp"
 
+#include <chrono>
+#include <iostream>
+
 enum class TriggerType
 {
   NO_TUNING,
@@ -34,7 +40,12 @@ class Trigger
   public:
     Trigger() = delete;
     Trigger(ParamsConfig cfg) :
-      preFilter_(100), filter_(100)
+      preFilter_(100), filter_(100), stability_(200, TRESHOLD),
+      isChangePointDetectionOn_(cfg.changePointDetection_),
+      changePointCooldown_(cfg.changePointCooldownInSec_),
+      ipsDetector_(cfg.changePointThreshold_),
+      powerDetector_(cfg.changePointThreshold_),
+      isPeriodicityDetectionOn_(cfg.periodicityDetection_)
       {
         if (cfg.repeatTuningPeriodInSec_ > 0)
         {
@@ -54,7 +65,8 @@ class Trigger
       {
         case TriggerType::SINGLE_TUNING_WITH_WAIT:
         case TriggerType::PERIODIC_TUNING_WITH_WAIT:
-          return filter_.getCleanedRelativeError() < TRESHOLD;
+          // stable idle power before the computation starts does not count
+          return hasDeviceReportedAnyComputeActivityThroughPerfCounter_ && isPowerProfileStable();
         case TriggerType::SINGLE_IMMEDIATE_TUNING:
         case TriggerType::PERIODIC_IMMEDIATE_TUNING:
           return hasDeviceReportedAnyComputeActivityThroughPerfCounter_;
@@ -64,6 +76,11 @@ class Trigger
       }
     }
 
+    bool isPowerProfileStable() const
+    {
+      return stability_.isStable();
+    }
+
     double getCurrentFilteredPowerInWatts() const
     {
       return filter_.getSMA();
@@ -71,9 +88,10 @@ class Trigger
 
     void appendPowerSampleToSmaFilter(double powerInWatts)
     {
-
+      // single sample spikes are not propagated to the filtered power
+      preFilter_.storeDataPoint(outlierRejector_.filter(powerInWatts));
       filter_.storeDataPoint(preFilter_.getSMA());
-      preFilter_.storeDataPoint(powerInWatts);
+      stability_.append(powerInWatts);
     }
 
     void updateComputeActivityFlag(bool computeActivityOfDeviceCondition)
@@ -87,11 +105,112 @@ class Trigger
       return isTuningPeriodic_;
     }
 
+    /*
+      updateChangePointDetectors - feeds CUSUM detectors with the next sample of
+      instructions per second and power of the application
+    */
+    void updateChangePointDetectors(double instructionsPerSecond, double powerInWatts)
+    {
+      if (!isChangePointDetectionOn_ || isChangePointDetectionFrozen_)
+      {
+        return;
+      }
+      const bool ipsChanged = ipsDetector_.update(instructionsPerSecond);
+      const bool powerChanged = powerDetector_.update(powerInWatts);
+      if ((ipsChanged || powerChanged) && !isPhaseChangeReported_)
+      {
+        isPhaseChangeReported_ = true;
+        std::cout << "[INFO] Change point detected in "
+                  << (ipsChanged ? "instructions per second" : "power") << " stream.\n";
+      }
+    }
+
+    /*
+      hasApplicationPhaseChanged - true when a change point was detected after the cooldown
+      since the last restartChangePointDetection()
+    */
+    bool hasApplicationPhaseChanged() const
+    {
+      return isPhaseChangeReported_ &&
+             std::chrono::steady_clock::now() - changePointDetectionStart_ >= changePointCooldown_;
+    }
+
+    /*
+      freezeChangePointDetection - while frozen the samples are not fed to the detectors, e.g.,
+      in short windows at other caps, which would look like a phase change of the application
+    */
+    void freezeChangePointDetection(bool frozen)
+    {
+      isChangePointDetectionFrozen_ = frozen;
+    }
+
+    /*
+      restartChangePointDetection - to be called after a new cap is applied, the baseline is
+      learnt again and no change is reported before the cooldown passes
+    */
+    void restartChangePointDetection()
+    {
+      ipsDetector_.restart();
+      powerDetector_.restart();
+      isPhaseChangeReported_ = false;
+      changePointDetectionStart_ = std::chrono::steady_clock::now();
+    }
+
+    /*
+      updatePeriodicityDetectors - collects the samples of instructions per second and power
+      between startPeriodicityDetection() and estimateApplicationPeriodInSeconds()
+    */
+    void updatePeriodicityDetectors(double instructionsPerSecond, double powerInWatts, double samplingPeriodInSeconds)
+    {
+      if (!isCollectingPeriodicitySamples_)
+      {
+        return;
+      }
+      ipsPeriodicity_.append(instructionsPerSecond, samplingPeriodInSeconds);
+      powerPeriodicity_.append(powerInWatts, samplingPeriodInSeconds);
+    }
+
+    void startPeriodicityDetection()
+    {
+      ipsPeriodicity_.reset();
+      powerPeriodicity_.reset();
+      isCollectingPeriodicitySamples_ = isPeriodicityDetectionOn_;
+    }
+
+    /*
+      estimateApplicationPeriodInSeconds - stops collecting the samples and returns the
+      period of the stream with the stronger autocorrelation, 0.0 if none is periodic
+    */
+    double estimateApplicationPeriodInSeconds()
+    {
+      isCollectingPeriodicitySamples_ = false;
+      if (!isPeriodicityDetectionOn_)
+      {
+        return 0.0;
+      }
+      const double ipsPeriod = ipsPeriodicity_.estimatePeriodInSeconds();
+      const double powerPeriod = powerPeriodicity_.estimatePeriodInSeconds();
+      return ipsPeriodicity_.getPeakCorrelation() >= powerPeriodicity_.getPeakCorrelation() ? ipsPeriod : powerPeriod;
+    }
+
   private:
     TriggerType type_;
     DataFilter filter_;
     DataFilter preFilter_;
+    HampelFilter outlierRejector_;
     double TRESHOLD {0.03};
+    StabilityDetector stability_;
     bool hasDeviceReportedAnyComputeActivityThroughPerfCounter_ {false};
     bool isTuningPeriodic_ {false};
+    bool isChangePointDetectionOn_ {false};
+    std::chrono::duration<double> changePointCooldown_;
+    CusumDetector ipsDetector_;
+    CusumDetector powerDetector_;
+    bool isPhaseChangeReported_ {false};
+    bool isChangePointDetectionFrozen_ {false};
+    std::chrono::steady_clock::time_point changePointDetectionStart_ {std::chrono::steady_clock::now()};
+    bool isPeriodicityDetectionOn_ {false};
+    bool isCollectingPeriodicitySamples_ {false};
+    PeriodicityDetector ipsPeriodicity_;
+    PeriodicityDetector powerPeriodicity_;
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include "eco_constants.hpp"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct TuningCacheEntry
+{
+    std::string command_;
+    std::string binaryHash_;
+    std::string device_;
+    std::string metric_;
+    double capInWatts_ {0.0};
+    double relativeCost_ {1.0}; // target metric at the cap relative to the default cap
+    std::vector<std::pair<double, double>> curve_; // measured (cap in Watts, relative cost)
+};
+
+/*
+  TuningCache - on-disk (YAML) store of the tuning results of previously run applications
+
+  Entries are keyed by the application fingerprint: the command line, the hash of the
+  executable, the device name and the target metric. The file is loaded on construction
+  and rewritten on each store().
+*/
+class TuningCache
+{
+public:
+    explicit TuningCache(std::string fileName);
+
+    /*
+      makeKey - fingerprint of the tuned application, fills the identification fields
+      of the entry as a side effect
+    */
+    static std::string makeKey(
+        char* const* argv,
+        const std::string& deviceName,
+        TargetMetric metric,
+        TuningCacheEntry& entry);
+    /*
+      hashExecutable - FNV-1a 64-bit hash of the file executed for the given command
+      (resolved through PATH when the command has no '/'), empty string when unreadable
+    */
+    static std::string hashExecutable(const std::string& command);
+
+    std::optional<TuningCacheEntry> find(const std::string& key) const;
+    void store(const std::string& key, const TuningCacheEntry& entry);
+    std::string getFileName() const { return fileName_; }
+
+private:
+    void load();
+    void save() const;
+
+    std::string fileName_;
+    std::map<std::string, TuningCacheEntry> entries_;
+};
@@ -16,48 +16,24 @@
 
 #include "data_structures/data_filter.hpp"
 
-#include <algorithm>
-
-double DataFilter::getSum() const
-{
-    double acc = 0.0;
-    for (auto&& dataPoint : data_) {
-        acc += dataPoint;
-    }
-    return acc;
-}
-
 double DataFilter::getSMA() const
 {
-    return getSum() / data_.size();
+    return sma_.getMean();
 }
 
 void DataFilter::storeDataPoint(double dataPoint) {
-    if (data_.size() == filterSize_) {
-        data_[activeIndex_] = dataPoint;
-        shiftActiveIndex();
-    } else {
-        data_.push_back(dataPoint);
-    }
-}
-
-void DataFilter::shiftActiveIndex() {
-    auto maxIndex = filterSize_ - 1;
-    if (activeIndex_ + 1 > maxIndex) {
-        activeIndex_ = 0; // reset active index
-    } else {
-        activeIndex_++; // move active index
-    }
+    sma_.add(dataPoint);
+    extrema_.push(dataPoint);
 }
 
 double DataFilter::getCleanedRelativeError() const
 {
-    if (data_.size() >1)
+    // mean without the extreme values needs at least one more data point
+    if (sma_.getCount() > 2)
     {
-        const auto minmax = std::minmax_element(data_.begin(), data_.end());
-        auto min = *minmax.first;
-        auto max = *minmax.second;
-        auto cleanedSMA = (getSum() - (min + max)) / (data_.size() - 2);
+        auto min = extrema_.getMin();
+        auto max = extrema_.getMax();
+        auto cleanedSMA = (sma_.getSum() - (min + max)) / (sma_.getCount() - 2);
         return (max - min) / cleanedSMA;
     }
     else
@@ -66,7 +42,10 @@ double DataFilter::getCleanedRelativeError() const
     }
 }
 
-double DataFilter::getRelativeError() {
-    const auto minmax = std::minmax_element(data_.begin(), data_.end());
-    return (*minmax.second - *minmax.first) / getSMA();
-}
\ No newline at end of file
+double DataFilter::getRelativeError() const {
+    if (extrema_.isEmpty())
+    {
+        return 1.00;
+    }
+    return (extrema_.getMax() - extrema_.getMin()) / getSMA();
+}
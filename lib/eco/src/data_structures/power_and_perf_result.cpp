@@ -47,6 +47,17 @@ bool PowAndPerfResult::isRightBetter(PowAndPerfResult& right, TargetMetric mode)
     }
 }
 
+double PowAndPerfResult::getRelativeCost(const PowAndPerfResult& reference, TargetMetric mode) const {
+    if (mode == TargetMetric::MIN_E) {
+        return getEnergyPerInstr() / reference.getEnergyPerInstr();
+    } else if (mode == TargetMetric::MIN_E_X_T) {
+        // getEnergyTimeProd() is the reverse of EDP per instruction squared
+        return reference.getEnergyTimeProd() / getEnergyTimeProd();
+    } else {
+        return myPlusMetric_;
+    }
+}
+
 double PowAndPerfResult::checkPlusMetric(PowAndPerfResult ref, double k) {
     myPlusMetric_ = (1.0/k) * (ref.getInstrPerSecond()/getInstrPerSecond()) *
                     ((k-1.0) * (averageCorePowerInWatts_ / ref.averageCorePowerInWatts_) + 1.0);
@@ -16,31 +16,88 @@
 
 #include "device_state.hpp"
 
+#include <numeric>
 #include <set>
+#include <stdexcept>
 
-DeviceStateAccumulator::DeviceStateAccumulator(std::shared_ptr<Device> d) :
+DeviceStateAccumulator::DeviceStateAccumulator(std::shared_ptr<Device> d, std::vector<std::shared_ptr<Device>> auxiliaryDevices) :
     absoluteStartTime_(std::chrono::high_resolution_clock::now()),
     timeOfLastReset_(std::chrono::high_resolution_clock::now()),
     device_(d),
+    auxiliaryDevices_(std::move(auxiliaryDevices)),
     prev_(0.0, 0, timeOfLastReset_),
     curr_(prev_),
     next_(prev_)
 {
+    if (auxiliaryDevices_.size() > MAX_AUXILIARY_DEVICES)
+    {
+        throw std::invalid_argument("DeviceStateAccumulator supports up to " +
+                                    std::to_string(MAX_AUXILIARY_DEVICES) + " auxiliary devices");
+    }
+}
+
+std::vector<std::shared_ptr<Device>> DeviceStateAccumulator::getDevices() const
+{
+    std::vector<std::shared_ptr<Device>> devices {device_};
+    devices.insert(devices.end(), auxiliaryDevices_.begin(), auxiliaryDevices_.end());
+    return devices;
+}
+
+void DeviceStateAccumulator::startBackgroundSampling(int periodInMilliSeconds)
+{
+    if (isBackgroundSamplingActive())
+    {
+        return;
+    }
+    sampler_ = std::make_unique<Sampler>([this] { return readDeviceState(); }, periodInMilliSeconds * 1000);
+    sampler_->start();
+}
+
+void DeviceStateAccumulator::stopBackgroundSampling()
+{
+    if (sampler_)
+    {
+        sampler_->stop();
+    }
+}
+
+void DeviceStateAccumulator::setSamplingPeriod(int periodInMilliSeconds)
+{
+    if (sampler_)
+    {
+        sampler_->setPeriodInMicroSeconds(periodInMilliSeconds * 1000);
+    }
+}
+
+int DeviceStateAccumulator::getSamplingPeriodInMilliSeconds() const
+{
+    return sampler_ ? sampler_->getPeriodInMicroSeconds() / 1000 : 0;
 }
 
 void DeviceStateAccumulator::resetState()
 {
-    device_->reset();
+    if (isBackgroundSamplingActive())
+    {
+        sampler_->runExclusively([this] { device_->reset(); });
+        // samples taken before the reset refer to the old counters' state
+        sampler_->dropPendingSamples();
+    }
+    else
+    {
+        device_->reset();
+    }
+    // the first sample is the baseline for the energy counter,
+    // only the energy consumed after it is accumulated
+    sample();
     timeOfLastReset_ = std::chrono::high_resolution_clock::now();
     totalEnergySinceReset_ = 0.0;
-    sample();
+    auxiliaryEnergySinceReset_.fill(0.0);
     sample();
 }
 
-DeviceStateAccumulator& DeviceStateAccumulator::sample()
+PowerAndPerfState DeviceStateAccumulator::readDeviceState()
 {
-    prev_ = curr_;
-    curr_ = next_;
+    const auto requestTime = std::chrono::high_resolution_clock::now();
     // ------------------------------------------------------------------
     // this is specific to Intel RAPL power/energy measurements:
     // in order to have any valid readings, RAPL must be sampled
@@ -49,25 +106,70 @@ DeviceStateAccumulator& DeviceStateAccumulator::sample()
     device_->triggerPowerApiSample();
     // for other devices like NVIDIA it is handled by the API (e.g., NVML)
     // ------------------------------------------------------------------
+    // with aligned sampling the device knows the counter update time
+    const auto timestamp = device_->getLastPowerApiSampleTime().value_or(requestTime);
     const auto  perfCounter = device_->getPerfCounter();
 
-    next_ = PowerAndPerfState(
+    PowerAndPerfState state(
         device_->getCurrentPowerInWatts(std::nullopt),
         perfCounter,
-        std::chrono::high_resolution_clock::now());
+        timestamp,
+        device_->getEnergyCounterInJoules());
+    state.memoryEnergy_ = device_->getMemoryEnergyCounterInJoules();
+    // auxiliary devices are only the energy source, their counters are read right
+    // after the tuned device, the skew of a counter read is cheaper than spawning
+    // a thread per device on every sample
+    for (std::size_t i = 0; i < auxiliaryDevices_.size(); i++)
+    {
+        auxiliaryDevices_[i]->triggerPowerApiSample();
+        state.auxiliaryEnergy_[i] = auxiliaryDevices_[i]->getEnergyCounterInJoules();
+    }
+    return state;
+}
+
+DeviceStateAccumulator& DeviceStateAccumulator::sample()
+{
+    prev_ = curr_;
+    curr_ = next_;
+    next_ = isBackgroundSamplingActive() ? sampler_->waitForNextSample() : readDeviceState();
 
-    auto timeDeltaMs = std::chrono::duration_cast<std::chrono::milliseconds>(next_.time_ - curr_.time_).count();
-    totalEnergySinceReset_ += next_.power_ * timeDeltaMs / 1000;
+    totalEnergySinceReset_ += next_.energy_ - curr_.energy_;
+    for (std::size_t i = 0; i < auxiliaryDevices_.size(); i++)
+    {
+        auxiliaryEnergySinceReset_[i] += next_.auxiliaryEnergy_[i] - curr_.auxiliaryEnergy_[i];
+    }
     return *this;
 }
 
 double DeviceStateAccumulator::getCurrentPower(Domain d)
 {
+    double power = 0.0;
+    if (isBackgroundSamplingActive())
+    {
+        sampler_->runExclusively([&] { power = device_->getCurrentPowerInWatts(d); });
+        return power;
+    }
     return device_->getCurrentPowerInWatts(d);
 }
 
+void DeviceStateAccumulator::attachPerfCounterToProcess(pid_t pid)
+{
+    if (isBackgroundSamplingActive())
+    {
+        sampler_->runExclusively([&] { device_->attachPerfCounterToProcess(pid); });
+        return;
+    }
+    device_->attachPerfCounterToProcess(pid);
+}
+
 double DeviceStateAccumulator::getPerfCounterSinceReset()
 {
+    double counter = 0.0;
+    if (isBackgroundSamplingActive())
+    {
+        sampler_->runExclusively([&] { counter = device_->getPerfCounter(); });
+        return counter;
+    }
     return device_->getPerfCounter();
 }
 
@@ -76,6 +178,20 @@ double DeviceStateAccumulator::getEnergySinceReset() const
     return totalEnergySinceReset_;
 }
 
+std::vector<double> DeviceStateAccumulator::getPerDeviceEnergySinceReset() const
+{
+    std::vector<double> result {totalEnergySinceReset_};
+    result.insert(result.end(), auxiliaryEnergySinceReset_.begin(),
+                  auxiliaryEnergySinceReset_.begin() + auxiliaryDevices_.size());
+    return result;
+}
+
+double DeviceStateAccumulator::getNodeEnergySinceReset() const
+{
+    auto perDevice = getPerDeviceEnergySinceReset();
+    return std::accumulate(perDevice.begin(), perDevice.end(), 0.0);
+}
+
 PowAndPerfResult DeviceStateAccumulator::getCurrentPowerAndPerf(std::optional<std::reference_wrapper<Trigger>> trigger) const
 {
     double perfCounterDelta = (double)(next_.kernelsCount_ - curr_.kernelsCount_);
@@ -84,26 +200,34 @@ PowAndPerfResult DeviceStateAccumulator::getCurrentPowerAndPerf(std::optional<st
         trigger->get().appendPowerSampleToSmaFilter(next_.power_);
         trigger->get().updateComputeActivityFlag(perfCounterDelta > 0.0);
     }
-    double timeDeltaMilliSeconds = std::chrono::duration_cast<std::chrono::milliseconds>(next_.time_ - curr_.time_).count();
-    return PowAndPerfResult(
+    const double timeDeltaSeconds = std::chrono::duration<double>(next_.time_ - curr_.time_).count();
+    if (trigger.has_value() && timeDeltaSeconds > 0.0)
+    {
+        trigger->get().updateChangePointDetectors(perfCounterDelta / timeDeltaSeconds, next_.power_);
+        trigger->get().updatePeriodicityDetectors(perfCounterDelta / timeDeltaSeconds, next_.power_, timeDeltaSeconds);
+    }
+    const double energyDelta = next_.energy_ - curr_.energy_;
+    const double memoryEnergyDelta = next_.memoryEnergy_ - curr_.memoryEnergy_;
+    PowAndPerfResult result(
         perfCounterDelta,
-        timeDeltaMilliSeconds / 1000,
+        timeDeltaSeconds,
         device_->getPowerLimitInWatts(),
-        next_.power_ * timeDeltaMilliSeconds / 1000, // Watts x seconds
-        next_.power_,
-        0.0, // memory power - not available for GPU
+        energyDelta,
+        timeDeltaSeconds > 0.0 ? energyDelta / timeDeltaSeconds : next_.power_,
+        timeDeltaSeconds > 0.0 ? memoryEnergyDelta / timeDeltaSeconds : 0.0, // 0.0 if memory is not measured (e.g., GPU)
         (trigger.has_value() ? trigger->get().getCurrentFilteredPowerInWatts() : -1.0) // TODO: this should be filtered power
         );
+    result.memoryEnergyInJoules_ = memoryEnergyDelta;
+    return result;
 }
 
-// Temporary disabled
-// ----------------------------------------------------------------------------------------
-// std::vector<double> DeviceStateAccumulator::getTotalEnergyVec(Domain d)
-// {
-//     std::vector<double> result;
-//     for (auto&& rapl : raplVec_) {
-//         result.push_back(rapl.getTotalEnergy()[d]);
-//     }
-//     return result;
-// }
-// ----------------------------------------------------------------------------------------
+std::vector<double> DeviceStateAccumulator::getTotalEnergyVec(Domain d)
+{
+    std::vector<double> result;
+    if (isBackgroundSamplingActive())
+    {
+        sampler_->runExclusively([&] { result = device_->getPerPackageEnergyInJoules(d); });
+        return result;
+    }
+    return device_->getPerPackageEnergyInJoules(d);
+}
@@ -15,6 +15,7 @@
 */
 
 #include "devices/cuda_device.hpp"
+#include "../../../src/logging.hpp"
 
 static inline
 void logCurrentRangeGSS(int a, int leftCandidateInMilliWatts, int rightCandidateInMilliWatts, int b)
@@ -122,6 +123,13 @@ CudaDevice::CudaDevice(int devID) :
     initDeviceHandles();
     std::cout << "DEBUG device handles initialized succesfully" << std::endl;
     defaultPowerLimitInWatts_ = this->getPowerLimitInWatts();
+    unsigned long long energyInMilliJoules = 0;
+    hasTotalEnergyCounter_ = NVML_SUCCESS == nvmlDeviceGetTotalEnergyConsumption(deviceHandles_[deviceID_], &energyInMilliJoules);
+    if (!hasTotalEnergyCounter_)
+    {
+        std::cout << "[INFO] NVML total energy counter not supported, energy will be integrated from power readings.\n";
+    }
+    timeOfLastPowerSample_ = std::chrono::high_resolution_clock::now();
 }
 
 double CudaDevice::getPowerLimitInWatts() const
@@ -185,12 +193,48 @@ double CudaDevice::getCurrentPowerInWatts(std::optional<Domain>) const
     nvmlReturn_t nvResult = nvmlDeviceGetPowerUsage(deviceHandles_[deviceID_], &power);
     if (NVML_SUCCESS != nvResult)
     {
-        printf("Failed to get power usage: %s\n", nvmlErrorString(nvResult));
+        LOG_ERROR("Failed to get power usage: {}", nvmlErrorString(nvResult));
         return -1.0;
     }
     return (double)power/1000.0;
 }
 
+double CudaDevice::getEnergyCounterInJoules() const
+{
+    if (!hasTotalEnergyCounter_)
+    {
+        return integratedEnergyInJoules_;
+    }
+    unsigned long long energyInMilliJoules = 0;
+    nvmlReturn_t nvResult = nvmlDeviceGetTotalEnergyConsumption(deviceHandles_[deviceID_], &energyInMilliJoules);
+    if (NVML_SUCCESS != nvResult)
+    {
+        // the last good value keeps the energy deltas of the accumulator non-negative
+        LOG_ERROR("Failed to get total energy consumption: {}", nvmlErrorString(nvResult));
+        return lastEnergyCounterInJoules_;
+    }
+    lastEnergyCounterInJoules_ = (double)energyInMilliJoules / 1000.0;
+    return lastEnergyCounterInJoules_;
+}
+
+void CudaDevice::triggerPowerApiSample()
+{
+    if (hasTotalEnergyCounter_)
+    {
+        return;
+    }
+    const auto now = std::chrono::high_resolution_clock::now();
+    const double timeDeltaInSeconds = std::chrono::duration<double>(now - timeOfLastPowerSample_).count();
+    const double power = getCurrentPowerInWatts();
+    if (power >= 0.0)
+    {
+        lastPowerInWatts_ = power;
+    }
+    // a failed reading is bridged with the last good one, so no interval is lost
+    integratedEnergyInJoules_ += lastPowerInWatts_ * timeDeltaInSeconds;
+    timeOfLastPowerSample_ = now;
+}
+
 void CudaDevice::initDeviceHandles()
 {
     nvmlDevice_t nvDevice;
@@ -23,6 +23,9 @@
 #include <fstream>
 #include <boost/filesystem.hpp>
 #include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 
 
 #define MAX_CPUS		1024
@@ -54,7 +57,8 @@ static inline void writeLimitToFile (std::string fileName, int limit) {
     outfile.close();
 }
 
-IntelDevice::IntelDevice()
+IntelDevice::IntelDevice(PerfCounterBackend perfCounterBackend) :
+    perfCounterBackend_(perfCounterBackend)
 {
     detectCPU();
     detectPackages();
@@ -62,18 +66,85 @@ IntelDevice::IntelDevice()
     prepareRaplDirsFromAvailableDomains();
     readAndStoreDefaultLimits();
     currentPowerLimitInWatts_ = totalPackages_ * raplDefaultCaps_.defaultConstrPKG_->longPower/ 1e6;
-    initPerformanceCounters();
+    // PCM programs the PMU system-wide so it is initialized only when used,
+    // otherwise it would interfere with the per-process perf_event counters
+    if (perfCounterBackend_ == PerfCounterBackend::PCM)
+    {
+        initPerformanceCounters();
+    }
     initRaplObjectsForEachPKG();
     checkIdlePowerConsumption();
+    startWrapGuard();
+}
+
+IntelDevice::~IntelDevice()
+{
+    stopWrapGuard();
+}
+
+void IntelDevice::startWrapGuard()
+{
+    // the worst case is the package running at its short term (PL2) limit all the time
+    const auto& pkgConstraints = *raplDefaultCaps_.defaultConstrPKG_;
+    double maxPowerInWatts = std::max(pkgConstraints.shortPower, pkgConstraints.longPower) / 1e6;
+    if (maxPowerInWatts <= 0.0)
+    {
+        maxPowerInWatts = 1000.0;
+    }
+    double wrapPeriod = std::numeric_limits<double>::infinity();
+    for (auto&& rapl : raplVec_)
+    {
+        wrapPeriod = std::min(wrapPeriod, rapl.getWrapPeriodInSeconds(maxPowerInWatts));
+    }
+    if (!std::isfinite(wrapPeriod))
+    {
+        // counters of the backend never wrap (e.g., perf)
+        return;
+    }
+    // tick four times per wrap period to tolerate scheduling delays
+    wrapGuardPeriodInSeconds_ = std::max(wrapPeriod / 4, 0.001);
+    std::cout << std::fixed << std::setprecision(3)
+              << "[INFO] IntelDevice RAPL counters may wrap every " << wrapPeriod
+              << " s, ticking every " << wrapGuardPeriodInSeconds_ << " s.\n";
+    stopWrapGuard_ = false;
+    wrapGuardThread_ = std::thread([this] {
+        const auto period = std::chrono::duration<double>(wrapGuardPeriodInSeconds_);
+        std::unique_lock<std::mutex> lock(raplMutex_);
+        while (!wrapGuardCv_.wait_for(lock, period, [this] { return stopWrapGuard_; }))
+        {
+            for (auto&& rapl : raplVec_)
+            {
+                rapl.tick();
+            }
+        }
+    });
+}
+
+void IntelDevice::stopWrapGuard()
+{
+    if (!wrapGuardThread_.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(raplMutex_);
+        stopWrapGuard_ = true;
+    }
+    wrapGuardCv_.notify_all();
+    wrapGuardThread_.join();
 }
 
 void IntelDevice::initRaplObjectsForEachPKG()
 {
-    for (auto&& cpuCore : this->getPkgToFirstCoreMap())
+    raplVec_.reserve(this->getPkgToFirstCoreMap().size());
+    for (std::size_t pkg = 0; pkg < pkgToFirstCoreMap_.size(); pkg++)
     {
-        raplVec_.emplace_back(cpuCore, this->getAvailablePowerDomains());
+        const auto cpuCore = pkgToFirstCoreMap_[pkg];
+        raplVec_.emplace_back(cpuCore, this->getAvailablePowerDomains(), raplDirs_.packagesDirs_[pkg]);
         std::cout << "INFO: created RAPL object for core " << cpuCore << " in DeviceStateAccumulator.\n";
     }
+    raplSeries_ = RaplSeriesStore(raplVec_.size());
+    lastEnergyIncrements_.resize(raplVec_.size());
 }
 
 std::pair<unsigned, unsigned> IntelDevice::getMinMaxLimitInWatts() const
@@ -396,9 +467,35 @@ double IntelDevice::getPowerLimitInWatts() const
 
 void IntelDevice::setPowerLimitInMicroWatts(unsigned long limitInMicroW)
 {
-    Domain dom = PowerCapDomain::PKG; // TODO: the domain is hardcoded so that it can fit generic API for CPU and GPU
-                                      //       It should be considered to drop support for PP0, PP1 domains and to
-                                      //       have separate API for DRAM domain.
+    // generic API for CPU and GPU limits the PKG domain only
+    setDomainLimitInMicroWatts(PowerCapDomain::PKG, limitInMicroW);
+}
+
+void IntelDevice::setPowerLimitsInMicroWatts(const PowerLimits& limits)
+{
+    for (auto&& [dom, limitInMicroW] : limits)
+    {
+        setDomainLimitInMicroWatts(dom, limitInMicroW);
+    }
+}
+
+std::pair<unsigned, unsigned> IntelDevice::getDomainMinMaxLimitInWatts(Domain dom) const
+{
+    if (dom == PowerCapDomain::PKG)
+    {
+        return getMinMaxLimitInWatts();
+    }
+    if (dom == PowerCapDomain::DRAM && devicePowerProfile_.dram_ && !raplDirs_.dramDirs_.empty() &&
+        raplDefaultCaps_.defaultConstrDRAM_ && raplDefaultCaps_.defaultConstrDRAM_->powerLimit > 0)
+    {
+        const unsigned maxLimit = totalPackages_ * raplDefaultCaps_.defaultConstrDRAM_->powerLimit / 1000000;
+        return std::make_pair(unsigned(maxLimit * DRAM_MIN_LIMIT_FRACTION), maxLimit);
+    }
+    return std::make_pair(0u, 0u);
+}
+
+void IntelDevice::setDomainLimitInMicroWatts(Domain dom, unsigned long limitInMicroW)
+{
     auto&& numPkgs = totalPackages_; // packagesDirs_.size();
     auto singlePKGcap = limitInMicroW / numPkgs;
     switch (dom) {
@@ -425,8 +522,9 @@ void IntelDevice::setPowerLimitInMicroWatts(unsigned long limitInMicroW)
             }
             break;
         case PowerCapDomain::DRAM :
+            // like for PKG, the limit is the total for all the packages
             for (auto& curentDRAMdir : raplDirs_.dramDirs_) {
-                writeLimitToFile(curentDRAMdir + raplDirs_.pl0dir_, limitInMicroW);
+                writeLimitToFile(curentDRAMdir + raplDirs_.pl0dir_, singlePKGcap);
                 writeLimitToFile(curentDRAMdir + raplDirs_.isEnabledDir_, 1);
             }
             break;
@@ -455,33 +553,99 @@ void IntelDevice::initPerformanceCounters()
 
 double IntelDevice::getCurrentPowerInWatts(std::optional<Domain> domain) const // this method shall have the input parameter "deviceID" back
 {
-    Domain d = Domain::PKG;
-    if (domain.has_value())
-    {
-        d = domain.value();
-    }
+    return raplSeries_.getCurrentPower(domain.value_or(Domain::PKG));
+}
+
+std::vector<double> IntelDevice::getPerPackageEnergyInJoules(Domain d) const
+{
+    return raplSeries_.getTotalEnergyPerPackage(d);
+}
+
+double IntelDevice::getEnergyCounterInJoules() const
+{
     double result = 0.0;
     for (auto&& rapl : raplVec_)
     {
-        result += rapl.getCurrentPower()[d];
+        result += rapl.pkg_energy_counter();
     }
     return result;
 }
 
+double IntelDevice::getMemoryEnergyCounterInJoules() const
+{
+    double result = 0.0;
+    if (devicePowerProfile_.dram_)
+    {
+        for (auto&& rapl : raplVec_)
+        {
+            result += rapl.dram_energy_counter();
+        }
+    }
+    return result;
+}
 
 void IntelDevice::reset()
 {
-    for (auto&& rapl : raplVec_)
     {
-        rapl.reset();
+        std::lock_guard<std::mutex> lock(raplMutex_);
+        for (auto&& rapl : raplVec_)
+        {
+            rapl.reset();
+        }
+    }
+    raplSeries_.reset();
+    if (perfEventCounter_)
+    {
+        instructionsAtReset_ = perfEventCounter_->read().instructions_;
     }
-    std::vector<pcm::SocketCounterState> dummySocketStates_;
+    if (pcm_)
+    {
+        std::vector<pcm::SocketCounterState> dummySocketStates_;
+        pcm_->getAllCounterStates(sysBeforeState_, dummySocketStates_, beforeState_);
+    }
+}
 
-    pcm_->getAllCounterStates(sysBeforeState_, dummySocketStates_, beforeState_);
+void IntelDevice::attachPerfCounterToProcess(pid_t pid)
+{
+    if (perfCounterBackend_ != PerfCounterBackend::PERF_EVENT)
+    {
+        return;
+    }
+    perfEventCounter_ = std::make_unique<PerfEventCounter>();
+    if (perfEventCounter_->attach(pid))
+    {
+        // counters of a new process start from zero
+        instructionsAtReset_ = 0;
+        return;
+    }
+    std::cerr << "[WARNING] IntelDevice: per-process instruction counting not available, falling back to system-wide PCM counters.\n";
+    perfEventCounter_.reset();
+    perfCounterBackend_ = PerfCounterBackend::PCM;
+    initPerformanceCounters();
+    reset();
+}
+
+void IntelDevice::setAlignedSampling(bool on)
+{
+    std::lock_guard<std::mutex> lock(raplMutex_);
+    alignedSampling_ = on;
+    for (auto&& rapl : raplVec_)
+    {
+        rapl.setAlignedSampling(on);
+    }
 }
 
 double IntelDevice::getNumInstructionsSinceReset() const
 {
+    if (perfEventCounter_)
+    {
+        return (double)(perfEventCounter_->read().instructions_ - instructionsAtReset_)/1000000;
+    }
+    if (!pcm_)
+    {
+        // no process attached yet
+        return 0.0;
+    }
     pcm::SystemCounterState sysAfterState_;
     std::vector<pcm::CoreCounterState> afterState_;
     std::vector<pcm::SocketCounterState> dummySocketStates_;
@@ -497,10 +661,28 @@ unsigned long long int IntelDevice::getPerfCounter() const
 
 void IntelDevice::triggerPowerApiSample()
 {
-    for (auto&& rapl : raplVec_)
+    std::lock_guard<std::mutex> lock(raplMutex_);
+    auto timestamp = std::chrono::high_resolution_clock::now();
+    std::chrono::high_resolution_clock::duration alignedOffsets {0};
+    for (std::size_t pkg = 0; pkg < raplVec_.size(); pkg++)
     {
-        rapl.sample();
+        raplVec_[pkg].sample();
+        raplVec_[pkg].getLastEnergyIncrementInJoules(lastEnergyIncrements_[pkg]);
+        alignedOffsets += raplVec_[pkg].getLastSampleTime() - timestamp;
     }
+    // each package is sampled at its own update edge, the mean edge time keeps the
+    // summed energy and the time deltas of consecutive samples consistent
+    if (alignedSampling_ && !raplVec_.empty())
+    {
+        timestamp += alignedOffsets / raplVec_.size();
+    }
+    lastSampleTime_ = timestamp;
+    raplSeries_.appendSample(timestamp, lastEnergyIncrements_);
+}
+
+double IntelDevice::getIdlePowerInWatts() const
+{
+    return idlePowerConsumption_;
 }
 
 void IntelDevice::checkIdlePowerConsumption()
@@ -509,19 +691,17 @@ void IntelDevice::checkIdlePowerConsumption()
     int idleCheckTimeSeconds = 10;
     int msPause = 100;
     std::cout << "\nChecking idle average power consumption for " << idleCheckTimeSeconds << "s.\n";
-    double energy = 0.0;
     reset();
+    const double energyAtStart = getEnergyCounterInJoules();
     const auto start = std::chrono::high_resolution_clock::now();
     for (auto i = 0; i < idleCheckTimeSeconds * 1000; i += msPause)
     {
         if (!(i%1000)) std::cout << "." << std::flush;
-        auto tmp = std::chrono::high_resolution_clock::now();
         usleep(msPause * 1000);
         triggerPowerApiSample();
-        auto timeDeltaMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - tmp).count();
-        energy += timeDeltaMs * getCurrentPowerInWatts() / 1000;
     }
-    double totalTimeInSeconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - start).count();
+    double energy = getEnergyCounterInJoules() - energyAtStart;
+    double totalTimeInSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
     std::cout << "\r";
     idlePowerConsumption_ = energy / totalTimeInSeconds;
     std::cout << std::fixed << std::setprecision(3)
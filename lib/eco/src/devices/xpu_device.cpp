@@ -466,6 +466,11 @@ double XPUDevice::getCurrentPowerInWatts(std::optional<Domain>) const
     return avg_power;
 }
 
+double XPUDevice::getEnergyCounterInJoules() const
+{
+    return static_cast<double>(energy_samples[1].energy) / 1e6;
+}
+
 zes_power_energy_counter_t XPUDevice::sampleEnergyCounter()
 {
     zes_power_energy_counter_t energy_counter;
@@ -26,6 +26,8 @@
 #include "logging/log.hpp"
 
 #include <atomic>
+#include <map>
+#include <cmath>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -51,15 +53,24 @@ void monitor_trigger_file() {
 
 static constexpr char FLUSH_AND_RETURN[] = "\r                                                                                     \r";
 
-Eco::Eco(std::shared_ptr<Device> d) :
-    device_(d), devStateGlobal_(d), trigger_(cfg_), logger_(d->getDeviceTypeString())
+Eco::Eco(std::shared_ptr<Device> d, std::vector<std::shared_ptr<Device>> auxiliaryDevices) :
+    device_(d), devStateGlobal_(d, std::move(auxiliaryDevices)), trigger_(cfg_), logger_(d->getDeviceTypeString()),
+    tuningWindowInMicroSeconds_(cfg_.usTestPhasePeriod_),
+    windowCalibrator_(cfg_.tuningWindowErrorFraction_ * cfg_.expectedMetricGap_)
 {
     defaultWatchdog = readWatchdog();
     if (defaultWatchdog == WatchdogStatus::ENABLED)
     {
         modifyWatchdog(WatchdogStatus::DISABLED);
     }
+    for (auto&& device : devStateGlobal_.getDevices())
+    {
+        device->setAlignedSampling(cfg_.alignedSampling_);
+    }
     device_->reset();
+    // from now on device is sampled with fixed rate by a dedicated thread and each
+    // sample() call consumes the next sample instead of sleeping for the sampling period
+    devStateGlobal_.startBackgroundSampling(cfg_.msPause_);
 }
 
 Eco::~Eco() {
@@ -121,7 +132,7 @@ void Eco::singleAppRunAndPowerSample(char* const* argv) {
         perror("open");
         std::abort();
     }
-    pid_t childProcId = fork();
+    pid_t childProcId = startMonitoredApp(argv, fd);
 
     if (childProcId < 0)
     {
@@ -130,12 +141,6 @@ void Eco::singleAppRunAndPowerSample(char* const* argv) {
         close(fd);
         return;
     }
-
-    if (childProcId == 0) {
-        // Child process
-        int ret = mainAppProcess(argv, fd);
-        std::exit(ret);
-    }
     // Parent process
     int status;
     pid_t result;
@@ -143,7 +148,6 @@ void Eco::singleAppRunAndPowerSample(char* const* argv) {
         result = waitpid(childProcId, &status, WNOHANG);
         if (result == 0) {
             // child alive - monitored app is running
-            usleep(cfg_.msPause_ * 1000);
             devStateGlobal_.sample();
             logger_.logPowerLogLine(devStateGlobal_, devStateGlobal_.getCurrentPowerAndPerf());
         } else if (result == -1) {
@@ -175,22 +179,131 @@ void Eco::singleAppRunAndPowerSample(char* const* argv) {
 
 PowAndPerfResult Eco::checkPowerAndPerformance(int usPeriod)
 {
-    auto pause = cfg_.msPause_ * 1000;
-    usleep(pause);
+    // sample() blocks until the background sampler delivers the next sample,
+    // the window is closed basing on the sampled time as the sampling period may vary
     devStateGlobal_.sample();
     auto resultAccumulator = devStateGlobal_.getCurrentPowerAndPerf(trigger_);
-    while (usPeriod > pause){
-        usleep(pause);
+    const double halfPeriodInMicroSeconds = devStateGlobal_.getSamplingPeriodInMilliSeconds() * 500.0;
+    // samples of the slowed down sampling are not comparable with the tuning ones
+    const bool isCalibrationSample = cfg_.autoTuningWindow_ && devStateGlobal_.getSamplingPeriodInMilliSeconds() == cfg_.msPause_;
+    if (isCalibrationSample) windowCalibrator_.append(resultAccumulator);
+    while (resultAccumulator.periodInSeconds_ * 1e6 + halfPeriodInMicroSeconds < usPeriod){
         devStateGlobal_.sample();
         auto tmp = devStateGlobal_.getCurrentPowerAndPerf(trigger_);
         logger_.logPowerLogLine(devStateGlobal_, tmp);
+        if (isCalibrationSample) windowCalibrator_.append(tmp);
         resultAccumulator += tmp;
-        usPeriod -= pause;
     }
 
     return resultAccumulator;
 }
 
+template <class SearchAlgorithmType, class... Args>
+static Algorithm makeAlgorithm(const ParamsConfig& cfg, Args&&... args)
+{
+    SearchAlgorithmType algorithm(std::forward<Args>(args)...);
+    algorithm.setPlusMetricK(cfg.k_);
+    if (cfg.equalWorkWindows_)
+    {
+        algorithm.setEqualWorkWindows(cfg.equalWorkMaxWindowStretch_);
+    }
+    if (cfg.earlyTermination_)
+    {
+        algorithm.setEarlyTermination(cfg.earlyTerminationMargin_);
+    }
+    return algorithm;
+}
+
+static void storeTuningResult(
+    TuningCache& cache,
+    const std::string& key,
+    TuningCacheEntry entry,
+    std::vector<PowAndPerfResult>& tuningWindows,
+    const PowAndPerfResult& reference,
+    TargetMetric metric,
+    double k,
+    int capInMicroWatts)
+{
+    std::map<double, StreamingStatistics> costPerCap;
+    for (auto&& window : tuningWindows)
+    {
+        window.checkPlusMetric(reference, k);
+        const double cost = window.getRelativeCost(reference, metric);
+        if (std::isfinite(cost))
+        {
+            costPerCap[window.appliedPowerCapInWatts_].add(cost);
+        }
+    }
+    entry.capInWatts_ = capInMicroWatts / 1e6;
+    entry.relativeCost_ = 1.0;
+    entry.curve_.clear();
+    double nearestDistance = INFINITY;
+    for (auto&& [cap, stats] : costPerCap)
+    {
+        entry.curve_.emplace_back(cap, stats.getMean());
+        // the returned cap might not be measured exactly (e.g., GSS midpoint)
+        if (std::abs(cap - entry.capInWatts_) < nearestDistance)
+        {
+            nearestDistance = std::abs(cap - entry.capInWatts_);
+            entry.relativeCost_ = stats.getMean();
+        }
+    }
+    cache.store(key, entry);
+    std::cout << "[INFO] Tuning result (" << entry.capInWatts_ << " W) stored in " << cache.getFileName() << "\n";
+}
+
+int Eco::verifyCachedPowerCap(
+    const std::optional<TuningCacheEntry>& entry,
+    PowAndPerfResult& reference,
+    TargetMetric metric)
+{
+    if (!entry.has_value())
+    {
+        std::cout << "[INFO] No cached tuning result for this application, running full search.\n";
+        return -1;
+    }
+    const int capInMicroWatts = entry->capInWatts_ * 1e6;
+    device_->setPowerLimitInMicroWatts(capInMicroWatts);
+    // the same window as the cached costs were measured with, so the noise levels match
+    auto result = checkPowerAndPerformance(tuningWindowInMicroSeconds_);
+    logger_.logPowerLogLine(devStateGlobal_, result, reference);
+    result.checkPlusMetric(reference, cfg_.k_);
+    const double cost = result.getRelativeCost(reference, metric);
+    const bool accepted = cost <= entry->relativeCost_ + cfg_.tuningCacheTolerance_;
+    std::cout << std::fixed << std::setprecision(3)
+              << "[INFO] Cached power cap " << entry->capInWatts_ << " W " << (accepted ? "verified" : "rejected")
+              << ": relative cost " << cost << " (cached " << entry->relativeCost_ << ")\n";
+    return accepted ? capInMicroWatts : -1;
+}
+
+void Eco::setFastSampling()
+{
+    devStateGlobal_.setSamplingPeriod(cfg_.msPause_);
+}
+
+void Eco::adaptSamplingPeriod()
+{
+    if (!cfg_.adaptiveSampling_)
+    {
+        return;
+    }
+    // back off geometrically as long as the filtered power is stable,
+    // any instability brings the sampling back to the base rate
+    if (trigger_.isPowerProfileStable())
+    {
+        const int current = devStateGlobal_.getSamplingPeriodInMilliSeconds();
+        const int next = std::min(cfg_.msPauseMax_, static_cast<int>(current * cfg_.samplingBackoffFactor_));
+        if (next != current)
+        {
+            devStateGlobal_.setSamplingPeriod(next);
+        }
+    }
+    else
+    {
+        setFastSampling();
+    }
+}
+
 // TODO: try to exclude printing from ECO
 static inline
 void printLine() {
@@ -220,24 +333,28 @@ void Eco::reportResult(double waitTime, double testTime) {
     auto&& totalE = devStateGlobal_.getEnergySinceReset();
     auto&& totalTime = devStateGlobal_.getTimeSinceReset<std::chrono::milliseconds>() / 1000.0;
     std::cout << "Total E: " << totalE;
-    // ----------------------------------------------------------------------------------------
-    // Below code is temporary disabled as it uses method specific to some
-    // class of systems with two Intel CPUs treated as a single device.
-    // Ultimately the Device shall represent single CPU and the energy readings
-    // shall be combined in DeviceStateAccumulator. If a system consist of
-    // multiple CPUs used by the same application it shall be reflected as multiple
-    // Device object instances within DeviceStateAccumulator.
-    //
-    //  || || || || || || || || || || || || || || || || ||
-    //  \/ \/ \/ \/ \/ \/ \/ \/ \/ \/ \/ \/ \/ \/ \/ \/ \/
-    //
-    // auto&& energyVec = devStateGlobal_.getTotalEnergyVec(Domain::PKG);
-    // int pkgID = 0;
-    // for (auto&& pkgE : energyVec) {
-    //     pkgID++;
-    //     std::cout << "\nPKG" << pkgID << ": " << pkgE << ", (" << (pkgE/totalE)*100 << "%)";
-    // }
-    // ----------------------------------------------------------------------------------------
+    // per package split is available only for devices made of multiple packages
+    auto&& energyVec = devStateGlobal_.getTotalEnergyVec(Domain::PKG);
+    if (energyVec.size() > 1) {
+        int pkgID = 0;
+        for (auto&& pkgE : energyVec) {
+            pkgID++;
+            std::cout << "\nPKG" << pkgID << ": " << pkgE << ", (" << (pkgE/totalE)*100 << "%)";
+        }
+    }
+    if (devStateGlobal_.hasAuxiliaryDevices())
+    {
+        auto&& devices = devStateGlobal_.getDevices();
+        auto&& energyPerDevice = devStateGlobal_.getPerDeviceEnergySinceReset();
+        auto&& nodeE = devStateGlobal_.getNodeEnergySinceReset();
+        for (std::size_t i = 0; i < devices.size(); i++)
+        {
+            std::cout << "\n" << devices[i]->getDeviceTypeString() << i << " (" << devices[i]->getName() << "): "
+                      << energyPerDevice[i] << ", (" << (energyPerDevice[i]/nodeE)*100 << "%)";
+        }
+        std::cout << "\nNode E: " << nodeE
+                  << "\nNode P: " << nodeE / totalTime;
+    }
     std::cout << "\nTotal P: " << totalE / totalTime <<
                  "\nTotal t: " << totalTime << "s\n";
     if (waitTime != 0.0 || testTime != 0.0) {
@@ -247,6 +364,8 @@ void Eco::reportResult(double waitTime, double testTime) {
 }
 
 void Eco::waitForTuningTrigger(int& status, int childPID) {
+    setFastSampling();
+    trigger_.startPeriodicityDetection();
     waitpid(childPID, &status, WNOHANG);
     while ((!trigger_.isDeviceReadyForTuning()) && status)
     {
@@ -257,33 +376,164 @@ void Eco::waitForTuningTrigger(int& status, int childPID) {
     }
     // std::cout << "\n";
     printLine();
+    detectApplicationPeriod();
+}
+
+void Eco::detectApplicationPeriod()
+{
+    if (!cfg_.periodicityDetection_)
+    {
+        return;
+    }
+    applicationPeriodInMicroSeconds_ = trigger_.estimateApplicationPeriodInSeconds() * 1e6;
+    if (applicationPeriodInMicroSeconds_ > 0.0)
+    {
+        std::cout << "[INFO] Application period detected: " << applicationPeriodInMicroSeconds_ / 1e3 << "ms.\n";
+    }
+    else
+    {
+        std::cout << "[INFO] No application period detected.\n";
+    }
+}
+
+void Eco::updateTuningWindow()
+{
+    double windowInMicroSeconds = cfg_.usTestPhasePeriod_;
+    if (cfg_.autoTuningWindow_)
+    {
+        windowInMicroSeconds = tuningWindowInMicroSeconds_;
+        if (auto calibrated = windowCalibrator_.getWindowInSeconds())
+        {
+            windowInMicroSeconds = std::clamp(*calibrated * 1e6, cfg_.msPause_ * 1e3, cfg_.msTestPhasePeriodMax_ * 1e3);
+            // the next calibration follows the current behaviour of the application
+            windowCalibrator_.reset();
+            std::cout << "[INFO] Tuning window calibrated to " << windowInMicroSeconds / 1e3 << "ms.\n";
+        }
+    }
+    if (applicationPeriodInMicroSeconds_ > 0.0 && applicationPeriodInMicroSeconds_ <= windowInMicroSeconds)
+    {
+        const double periods = std::round(windowInMicroSeconds / applicationPeriodInMicroSeconds_);
+        windowInMicroSeconds = periods * applicationPeriodInMicroSeconds_;
+        std::cout << "[INFO] Tuning window aligned to " << periods << " application periods ("
+                  << windowInMicroSeconds / 1e3 << "ms).\n";
+    }
+    tuningWindowInMicroSeconds_ = static_cast<int>(windowInMicroSeconds);
 }
 
-void Eco::execPhase(
+int Eco::execPhase(
     int powerCap_uW,
     int& status,
     int childPID,
-    PowAndPerfResult& refResult)
+    PowAndPerfResult& refResult,
+    TargetMetric metric,
+    ExecPhaseExit& exitReason)
 {
     int repetitionPeriodInUs = cfg_.repeatTuningPeriodInSec_ * 1e6 + cfg_.usTestPhasePeriod_;
     device_->setPowerLimitInMicroWatts(powerCap_uW);
+    int appliedCapInMicroWatts = powerCap_uW;
+    int exploitationCapInMicroWatts = powerCap_uW;
+    std::optional<ThompsonSamplingController> bandit;
+    if (cfg_.execPhaseExplorationFraction_ > 0.0)
+    {
+        const auto [minLimitInWatts, maxLimitInWatts] = device_->getMinMaxLimitInWatts();
+        bandit.emplace(minLimitInWatts,
+                       maxLimitInWatts,
+                       powerCap_uW / 1e6,
+                       cfg_.execPhaseExplorationFraction_,
+                       tuningWindowInMicroSeconds_ / 1e6);
+    }
+    // power profile changes right after the cap is applied
+    setFastSampling();
+    trigger_.restartChangePointDetection();
     printLine();
+    exitReason = ExecPhaseExit::PERIODIC_REPETITION;
     while (status && repetitionPeriodInUs > 0)
     {
-        auto papResult = checkPowerAndPerformance(cfg_.usTestPhasePeriod_);
-        repetitionPeriodInUs = trigger_.isTuningPeriodic() ? repetitionPeriodInUs - cfg_.usTestPhasePeriod_ : repetitionPeriodInUs;
+        ThompsonSamplingController::Decision decision {exploitationCapInMicroWatts / 1e6, false};
+        if (bandit)
+        {
+            decision = bandit->next();
+        }
+        const int capInMicroWatts = decision.capInWatts_ * 1e6;
+        if (capInMicroWatts != appliedCapInMicroWatts)
+        {
+            device_->setPowerLimitInMicroWatts(capInMicroWatts);
+            appliedCapInMicroWatts = capInMicroWatts;
+            setFastSampling();
+        }
+        // exploratory windows are as short as the tuning ones and keep the detectors'
+        // baseline of the exploitation cap
+        trigger_.freezeChangePointDetection(decision.isExploration_);
+        auto papResult = checkPowerAndPerformance(decision.isExploration_ ? tuningWindowInMicroSeconds_ : cfg_.usTestPhasePeriod_);
+        repetitionPeriodInUs = trigger_.isTuningPeriodic() ? repetitionPeriodInUs - papResult.periodInSeconds_ * 1e6 : repetitionPeriodInUs;
+        adaptSamplingPeriod();
 
         logger_.logPowerLogLine(devStateGlobal_, papResult, refResult);
+        if (bandit)
+        {
+            papResult.checkPlusMetric(refResult, cfg_.k_);
+            if (bandit->update(decision, papResult.getRelativeCost(refResult, metric), papResult.periodInSeconds_))
+            {
+                exploitationCapInMicroWatts = bandit->getExploitationCapInWatts() * 1e6;
+                std::cout << "[INFO] Execution phase cap moved to " << exploitationCapInMicroWatts / 1e6 << "W.\n";
+                // the exploited cap has changed, so has the baseline of the detectors
+                trigger_.restartChangePointDetection();
+            }
+        }
         waitpid(childPID, &status, WNOHANG);
         if (external_trigger_flag.load())
         {
             std::cout << "[INFO] External trigger received during execution phase. Re-tuning parameters...\n";
             external_trigger_flag.store(false);
+            exitReason = ExecPhaseExit::EXTERNAL_TRIGGER;
+            break;
+        }
+        if (trigger_.hasApplicationPhaseChanged())
+        {
+            std::cout << "[INFO] Application phase change detected during execution phase. Re-tuning parameters...\n";
+            exitReason = ExecPhaseExit::PHASE_CHANGE;
+            break;
+        }
+    }
+    trigger_.freezeChangePointDetection(false);
+    if (!status)
+    {
+        exitReason = ExecPhaseExit::APPLICATION_FINISHED;
+    }
+    std::cout << "\n";
+    printLine();
+    return exploitationCapInMicroWatts;
+}
+
+int Eco::onlineTuningPhase(
+    int& status,
+    int childPID,
+    PowAndPerfResult& refResult,
+    TargetMetric metric)
+{
+    const auto [minLimitInWatts, maxLimitInWatts] = device_->getMinMaxLimitInWatts();
+    PerturbAndObserveController controller(minLimitInWatts, maxLimitInWatts, device_->getPowerLimitInWatts());
+    int capInMicroWatts = controller.getCapInWatts() * 1e6;
+    setFastSampling();
+    printLine();
+    while (status)
+    {
+        device_->setPowerLimitInMicroWatts(capInMicroWatts);
+        auto papResult = checkPowerAndPerformance(tuningWindowInMicroSeconds_);
+        logger_.logPowerLogLine(devStateGlobal_, papResult, refResult);
+        papResult.checkPlusMetric(refResult, cfg_.k_);
+        capInMicroWatts = controller.update(papResult.getRelativeCost(refResult, metric)) * 1e6;
+        waitpid(childPID, &status, WNOHANG);
+        if (external_trigger_flag.load())
+        {
+            std::cout << "[INFO] External trigger received during online tuning. Re-measuring reference...\n";
+            external_trigger_flag.store(false);
             break;
         }
     }
     std::cout << "\n";
     printLine();
+    return capInMicroWatts;
 }
 
 int& Eco::adjustHighPowLimit(PowAndPerfResult firstResult, int& currHighLimit_uW)
@@ -302,6 +552,34 @@ int& Eco::adjustHighPowLimit(PowAndPerfResult firstResult, int& currHighLimit_uW
     return currHighLimit_uW;
 }
 
+pid_t Eco::startMonitoredApp(char* const* argv, int& stdoutFileDescriptor)
+{
+    // the child waits for the parent to attach the performance counters before
+    // executing the application, so that the whole workload is counted
+    int startPipe[2];
+    if (pipe(startPipe) < 0) {
+        perror("pipe");
+        abort();
+    }
+    pid_t childProcId = fork();
+    if (childProcId == 0) {
+        close(startPipe[1]);
+        char startSignal;
+        while (read(startPipe[0], &startSignal, 1) < 0 && errno == EINTR) {}
+        close(startPipe[0]);
+        std::exit(mainAppProcess(argv, stdoutFileDescriptor));
+    }
+    close(startPipe[0]);
+    if (childProcId > 0) {
+        devStateGlobal_.attachPerfCounterToProcess(childProcId);
+        if (write(startPipe[1], "s", 1) < 0) {
+            perror("write");
+        }
+    }
+    close(startPipe[1]);
+    return childProcId;
+}
+
 int Eco::mainAppProcess(char* const* argv, int& stdoutFileDescriptor)
 {
     if (dup2(stdoutFileDescriptor, 1) < 0) {
@@ -343,45 +621,112 @@ FinalPowerAndPerfResult Eco::runAppWithSearch(
     std::thread monitor_thread(monitor_trigger_file);
     // ----------------------------------------------------------------------------
     devStateGlobal_.resetState();
+    windowCalibrator_.setTargetMetric(targerMetric);
 
     double waitTime = 0.0, testTime = 0.0;
     int bestResultCapInMicroWatts = -1;
-    pid_t childProcId = fork();
-    if (childProcId >= 0) //fork successful
+    pid_t childProcId = startMonitoredApp(argv, fd);
+    if (childProcId > 0) //fork successful
     {
-        if (childProcId == 0) // child process
+        int status = 1;
+        printHeader();
+        waitTime = measureDuration([&, this] {
+            waitForTuningTrigger(status, childProcId);
+        });
+        //----------------------------------------------------------------------------
+        Algorithm algorithm;
+        if (searchType == SearchType::LINEAR_SEARCH)
+        {
+            algorithm = makeAlgorithm<LinearSearchAlgorithm>(cfg_);
+        }
+        else if (searchType == SearchType::BAYESIAN_OPTIMIZATION)
+        {
+            algorithm = makeAlgorithm<BayesianOptimizationSearchAlgorithm>(cfg_);
+        }
+        else if (searchType == SearchType::NOISE_AWARE_GOLDEN_SECTION_SEARCH)
+        {
+            algorithm = makeAlgorithm<NoiseAwareGoldenSectionSearchAlgorithm>(cfg_);
+        }
+        else if (searchType == SearchType::MODEL_BASED_SEARCH)
+        {
+            algorithm = makeAlgorithm<ModelBasedSearchAlgorithm>(cfg_);
+        }
+        else if (searchType == SearchType::PKG_DRAM_COORDINATE_DESCENT)
+        {
+            algorithm = makeAlgorithm<PkgDramCoordinateDescentAlgorithm>(cfg_);
+        }
+        else
+        {
+            algorithm = makeAlgorithm<GoldenSectionSearchAlgorithm>(cfg_);
+        }
+        //----------------------------------------------------------------------------
+        PowAndPerfResult referenceRun;
+        // local re-tuning applies to the searches of the PKG limit only
+        const bool isLocalRetuningOn = cfg_.localRetuning_ &&
+                                       searchType != SearchType::PKG_DRAM_COORDINATE_DESCENT &&
+                                       searchType != SearchType::ONLINE_PERTURB_AND_OBSERVE;
+        auto measurementCache = std::make_shared<MeasurementCache>(cfg_.retuningCacheHalfLifeInSec_);
+        int previousBestCapInMicroWatts = -1;
+        std::optional<TuningCache> tuningCache;
+        TuningCacheEntry cacheEntry;
+        std::string cacheKey;
+        if (!cfg_.tuningCacheFile_.empty())
         {
-            mainAppProcess(argv, fd);
+            tuningCache.emplace(cfg_.tuningCacheFile_);
+            cacheKey = TuningCache::makeKey(argv, device_->getName(), targerMetric, cacheEntry);
         }
-        else  // parent process
+        while (status)
         {
-            int status = 1;
-            printHeader();
-            waitTime = measureDuration([&, this] {
-                waitForTuningTrigger(status, childProcId);
+            testTime += measureDuration([&, this] {
+                setFastSampling();
+                updateTuningWindow();
+                referenceRun = checkPowerAndPerformance(cfg_.referenceRunMultiplier_ * tuningWindowInMicroSeconds_);
+                logger_.logPowerLogLine(devStateGlobal_, referenceRun);
+                bestResultCapInMicroWatts = -1;
+                if (searchType == SearchType::ONLINE_PERTURB_AND_OBSERVE)
+                {
+                    return;
+                }
+                if (tuningCache)
+                {
+                    bestResultCapInMicroWatts = verifyCachedPowerCap(tuningCache->find(cacheKey), referenceRun, targerMetric);
+                }
+                if (bestResultCapInMicroWatts < 0)
+                {
+                    logger_.startRecordingTuningWindows();
+                    auto currentAlgorithm = algorithm;
+                    if (isLocalRetuningOn && previousBestCapInMicroWatts > 0)
+                    {
+                        std::cout << "[INFO] Re-tuning around the previous optimum " << previousBestCapInMicroWatts / 1e6 << "W.\n";
+                        currentAlgorithm = makeAlgorithm<LocalRetuningSearchAlgorithm>(cfg_, previousBestCapInMicroWatts, measurementCache);
+                    }
+                    bestResultCapInMicroWatts = currentAlgorithm(device_, devStateGlobal_, trigger_, targerMetric, referenceRun, status, childProcId, cfg_.msPause_, tuningWindowInMicroSeconds_ / 1000, logger_);
+                    auto tuningWindows = logger_.stopRecordingTuningWindows();
+                    // search interrupted by the end of the app is not representative
+                    if (tuningCache && status)
+                    {
+                        storeTuningResult(*tuningCache, cacheKey, cacheEntry, tuningWindows, referenceRun,
+                                          targerMetric, cfg_.k_, bestResultCapInMicroWatts);
+                    }
+                }
             });
-            //----------------------------------------------------------------------------
-            Algorithm algorithm;
-            if (searchType == SearchType::LINEAR_SEARCH)
-            {
-                algorithm = LinearSearchAlgorithm();
-            }
-            else
+            if (searchType == SearchType::ONLINE_PERTURB_AND_OBSERVE)
             {
-                algorithm = GoldenSectionSearchAlgorithm();
+                // limits are not restored, after an external trigger the reference is measured
+                // with the current cap which is fine as only consecutive windows are compared
+                bestResultCapInMicroWatts = onlineTuningPhase(status, childProcId, referenceRun, targerMetric);
+                continue;
             }
-            //----------------------------------------------------------------------------
-            PowAndPerfResult referenceRun;
-            while (status)
+            ExecPhaseExit exitReason;
+            previousBestCapInMicroWatts = execPhase(bestResultCapInMicroWatts, status, childProcId, referenceRun, targerMetric, exitReason);
+            if (exitReason == ExecPhaseExit::PHASE_CHANGE || exitReason == ExecPhaseExit::EXTERNAL_TRIGGER)
             {
-                testTime += measureDuration([&, this] {
-                    referenceRun = checkPowerAndPerformance(cfg_.referenceRunMultiplier_ * cfg_.usTestPhasePeriod_);
-                    logger_.logPowerLogLine(devStateGlobal_, referenceRun);
-                    bestResultCapInMicroWatts = algorithm(device_, devStateGlobal_, trigger_, targerMetric, referenceRun, status, childProcId, cfg_.msPause_, cfg_.msTestPhasePeriod_, logger_);
-                });
-                execPhase(bestResultCapInMicroWatts, status, childProcId, referenceRun);
-                device_->restoreDefaultLimits();
+                // neither the previous optimum nor the old measurements describe the application
+                // anymore, local re-tuning is kept for the periodic repetitions only
+                measurementCache->clear();
+                previousBestCapInMicroWatts = -1;
             }
+            device_->restoreDefaultLimits();
         }
     }
     else
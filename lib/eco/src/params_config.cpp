@@ -53,6 +53,53 @@ void ParamsConfig::printConfigExplained()
             << repeatTuningPeriodInSec_ << " seconds.\n";
     std::cout << "\tDEPO will DO "
             << (doWaitPhase_ ? "" : "NOT") << " wait for steady power consumption profile basing on SMA filtered power reading.\n";
+    if (adaptiveSampling_)
+    {
+        std::cout << "\tAdaptive sampling ENABLED: sampling time grows " << samplingBackoffFactor_
+                  << "x per stable period up to " << msPauseMax_ << "ms during execution phase.\n";
+    }
+    std::cout << "\tSamples are "
+            << (alignedSampling_ ? "" : "NOT ") << "aligned with energy counter updates.\n";
+    if (autoTuningWindow_)
+    {
+        std::cout << "\tTuning window is calibrated to the relative standard error of "
+                  << tuningWindowErrorFraction_ * expectedMetricGap_ * 100 << "% (at most "
+                  << msTestPhasePeriodMax_ / 1000.0 << "s).\n";
+    }
+    if (equalWorkWindows_)
+    {
+        std::cout << "\tTuning windows end after the work done in the reference window (at most "
+                  << equalWorkMaxWindowStretch_ << "x longer).\n";
+    }
+    if (earlyTermination_)
+    {
+        std::cout << "\tTuning windows of candidates worse than the best one by "
+                  << earlyTerminationMargin_ * 100 << "% are ended early (sequential probability ratio test).\n";
+    }
+    if (localRetuning_)
+    {
+        std::cout << "\tRepeated Tuning Phases search around the previous optimum (cached measurements half-life "
+                  << retuningCacheHalfLifeInSec_ << "s).\n";
+    }
+    if (execPhaseExplorationFraction_ > 0.0)
+    {
+        std::cout << "\tUp to " << execPhaseExplorationFraction_ * 100
+                  << "% of Execution Phase is spent exploring the neighbouring caps (Thompson sampling).\n";
+    }
+    if (periodicityDetection_)
+    {
+        std::cout << "\tTuning windows will be aligned to whole periods of the application detected in Wait Phase.\n";
+    }
+    if (changePointDetection_)
+    {
+        std::cout << "\tTuning phase will be repeated on change point detection (CUSUM threshold "
+                  << changePointThreshold_ << ", cooldown " << changePointCooldownInSec_ << "s).\n";
+    }
+    if (!tuningCacheFile_.empty())
+    {
+        std::cout << "\tTuning results are cached in " << tuningCacheFile_
+                  << ", cached cap is accepted if its metric is within " << tuningCacheTolerance_ * 100 << "% of the cached one.\n";
+    }
     }
 
 
@@ -76,5 +123,90 @@ void ParamsConfig::loadConfig()
     doWaitPhase_ = config["doWaitPhase"].as<int>();
     referenceRunMultiplier_ = config["referenceRunMultiplier"].as<int>();
     usTestPhasePeriod_ = msTestPhasePeriod_ * 1000;
+    // optional parameters - defaults are kept when missing in config file
+    if (config["adaptiveSampling"])
+    {
+        adaptiveSampling_ = config["adaptiveSampling"].as<int>();
+    }
+    if (config["msPauseMax"])
+    {
+        msPauseMax_ = config["msPauseMax"].as<int>();
+    }
+    if (config["samplingBackoffFactor"])
+    {
+        samplingBackoffFactor_ = config["samplingBackoffFactor"].as<double>();
+    }
+    if (config["alignedSampling"])
+    {
+        alignedSampling_ = config["alignedSampling"].as<int>();
+    }
+    if (config["autoTuningWindow"])
+    {
+        autoTuningWindow_ = config["autoTuningWindow"].as<int>();
+    }
+    if (config["expectedMetricGap"])
+    {
+        expectedMetricGap_ = config["expectedMetricGap"].as<double>();
+    }
+    if (config["tuningWindowErrorFraction"])
+    {
+        tuningWindowErrorFraction_ = config["tuningWindowErrorFraction"].as<double>();
+    }
+    if (config["msTestPhasePeriodMax"])
+    {
+        msTestPhasePeriodMax_ = config["msTestPhasePeriodMax"].as<int>();
+    }
+    if (config["equalWorkWindows"])
+    {
+        equalWorkWindows_ = config["equalWorkWindows"].as<int>();
+    }
+    if (config["equalWorkMaxWindowStretch"])
+    {
+        equalWorkMaxWindowStretch_ = config["equalWorkMaxWindowStretch"].as<double>();
+    }
+    if (config["earlyTermination"])
+    {
+        earlyTermination_ = config["earlyTermination"].as<int>();
+    }
+    if (config["earlyTerminationMargin"])
+    {
+        earlyTerminationMargin_ = config["earlyTerminationMargin"].as<double>();
+    }
+    if (config["localRetuning"])
+    {
+        localRetuning_ = config["localRetuning"].as<int>();
+    }
+    if (config["retuningCacheHalfLifeInSec"])
+    {
+        retuningCacheHalfLifeInSec_ = config["retuningCacheHalfLifeInSec"].as<double>();
+    }
+    if (config["execPhaseExplorationFraction"])
+    {
+        execPhaseExplorationFraction_ = config["execPhaseExplorationFraction"].as<double>();
+    }
+    if (config["periodicityDetection"])
+    {
+        periodicityDetection_ = config["periodicityDetection"].as<int>();
+    }
+    if (config["changePointDetection"])
+    {
+        changePointDetection_ = config["changePointDetection"].as<int>();
+    }
+    if (config["changePointThreshold"])
+    {
+        changePointThreshold_ = config["changePointThreshold"].as<double>();
+    }
+    if (config["changePointCooldownInSec"])
+    {
+        changePointCooldownInSec_ = config["changePointCooldownInSec"].as<double>();
+    }
+    if (config["tuningCacheFile"])
+    {
+        tuningCacheFile_ = config["tuningCacheFile"].as<std::string>();
+    }
+    if (config["tuningCacheTolerance"])
+    {
+        tuningCacheTolerance_ = config["tuningCacheTolerance"].as<double>();
+    }
     // return cfg;
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "perf_counter_interfaces/perf_event_counter.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static constexpr std::array<uint64_t, 2> COUNTED_EVENTS {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES};
+
+static inline long perfEventOpen(perf_event_attr* attr, pid_t pid, int cpu, int groupFd, unsigned long flags)
+{
+    return syscall(__NR_perf_event_open, attr, pid, cpu, groupFd, flags);
+}
+
+static inline uint64_t scale(uint64_t value, uint64_t timeEnabled, uint64_t timeRunning)
+{
+    if (timeRunning == 0)
+    {
+        return 0;
+    }
+    if (timeRunning >= timeEnabled)
+    {
+        return value;
+    }
+    return static_cast<uint64_t>(static_cast<double>(value) * timeEnabled / timeRunning);
+}
+
+PerfEventCounter::~PerfEventCounter()
+{
+    detach();
+}
+
+int PerfEventCounter::openCounter(uint64_t config, pid_t pid, int groupFd, bool enableOnExec, bool asGroup)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.inherit = 1;
+    attr.exclude_hv = 1;
+    attr.exclude_kernel = excludeKernel_ ? 1 : 0;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    if (asGroup)
+    {
+        attr.read_format |= PERF_FORMAT_GROUP;
+    }
+    // group members follow the leader, only the leader is enabled on exec
+    const bool isLeader = groupFd == -1;
+    attr.disabled = isLeader ? 1 : 0;
+    attr.enable_on_exec = (isLeader && enableOnExec) ? 1 : 0;
+    return static_cast<int>(perfEventOpen(&attr, pid, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+bool PerfEventCounter::attach(pid_t pid, bool enableOnExec)
+{
+    detach();
+    // try the group read first, older kernels do not support inherited groups (EINVAL)
+    // and unprivileged users may count only the user space (EACCES)
+    for (bool asGroup : {true, false})
+    {
+        for (bool excludeKernel : {false, true})
+        {
+            excludeKernel_ = excludeKernel;
+            isGroupRead_ = asGroup;
+            int leader = -1;
+            bool success = true;
+            for (auto&& event : COUNTED_EVENTS)
+            {
+                int fd = openCounter(event, pid, asGroup ? leader : -1, enableOnExec, asGroup);
+                if (fd < 0)
+                {
+                    success = false;
+                    break;
+                }
+                fds_.push_back(fd);
+                if (leader == -1)
+                {
+                    leader = fd;
+                }
+            }
+            if (success)
+            {
+                if (!enableOnExec && asGroup)
+                {
+                    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                }
+                else if (!enableOnExec)
+                {
+                    for (auto&& fd : fds_)
+                    {
+                        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                    }
+                }
+                return true;
+            }
+            const int openErrno = errno;
+            detach();
+            if (openErrno != EACCES && openErrno != EPERM && openErrno != EINVAL)
+            {
+                std::cerr << "[WARNING] perf_event_open failed: " << std::strerror(openErrno) << "\n";
+                return false;
+            }
+        }
+    }
+    std::cerr << "[WARNING] perf_event_open failed: " << std::strerror(errno)
+              << " (check /proc/sys/kernel/perf_event_paranoid)\n";
+    return false;
+}
+
+void PerfEventCounter::detach()
+{
+    for (auto&& fd : fds_)
+    {
+        close(fd);
+    }
+    fds_.clear();
+}
+
+PerfEventReading PerfEventCounter::read() const
+{
+    PerfEventReading result;
+    std::array<uint64_t, COUNTED_EVENTS.size()> values {};
+    if (isGroupRead_ && !fds_.empty())
+    {
+        // { nr, time_enabled, time_running, value[nr] }
+        std::array<uint64_t, 3 + COUNTED_EVENTS.size()> buffer {};
+        if (::read(fds_[0], buffer.data(), sizeof(buffer)) > 0)
+        {
+            for (std::size_t i = 0; i < values.size() && i < buffer[0]; i++)
+            {
+                values[i] = scale(buffer[3 + i], buffer[1], buffer[2]);
+            }
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < fds_.size(); i++)
+        {
+            // { value, time_enabled, time_running }
+            std::array<uint64_t, 3> buffer {};
+            if (::read(fds_[i], buffer.data(), sizeof(buffer)) > 0)
+            {
+                values[i] = scale(buffer[0], buffer[1], buffer[2]);
+            }
+        }
+    }
+    result.instructions_ = values[0];
+    result.cycles_ = values[1];
+    return result;
+}
@@ -16,6 +16,9 @@
 
 #include "power_interface/Rapl.hpp"
 
+#include <algorithm>
+#include <limits>
+
 
 AvailableRaplPowerDomains::AvailableRaplPowerDomains (bool p0, bool p1, bool d, bool ps, bool du) :
     pp0_(p0), pp1_(p1), dram_(d), psys_(ps), fixedDramUnits_(du)
@@ -43,12 +46,11 @@ void RaplStateSequence::reset() {
 	previous_ = current_ = next_ = emptyState;
 }
 
-uint64_t RaplStateSequence::energyDelta(uint64_t before, uint64_t after) const
+uint64_t RaplStateSequence::energyDelta(uint64_t before, uint64_t after, Domain d) const
 {
     if (before > after) {
-		// Check for overflow
-        constexpr uint64_t MAX_INT = ~((uint32_t) 0);
-        return uint64_t(after + (MAX_INT - before));
+		// Check for overflow, range of 0 stands for 2^64 so unsigned arithmetic handles it
+        return uint64_t(after + (wrapRanges_[d] - before));
     }
 	else {
         return uint64_t (after - before);
@@ -67,19 +69,19 @@ double RaplStateSequence::getTotalTime(TimePoint startTime) const
 
 RaplState RaplStateSequence::getCurrentEnergyIncrement() const
 {
-    return RaplState(energyDelta(current_.pkg_, next_.pkg_),
-	                 energyDelta(current_.pp0_, next_.pp0_),
-					 energyDelta(current_.pp1_, next_.pp1_),
-					 energyDelta(current_.dram_, next_.dram_),
+    return RaplState(energyDelta(current_.pkg_, next_.pkg_, Domain::PKG),
+	                 energyDelta(current_.pp0_, next_.pp0_, Domain::PP0),
+					 energyDelta(current_.pp1_, next_.pp1_, Domain::PP1),
+					 energyDelta(current_.dram_, next_.dram_, Domain::DRAM),
 					 std::chrono::high_resolution_clock::now()); // probably does not matter
 }
 
 RaplState RaplStateSequence::getPreviousEnergyIncrement() const
 {
-    return RaplState(energyDelta(previous_.pkg_, current_.pkg_),
-	                 energyDelta(previous_.pp0_, current_.pp0_),
-					 energyDelta(previous_.pp1_, current_.pp1_),
-					 energyDelta(previous_.dram_, current_.dram_),
+    return RaplState(energyDelta(previous_.pkg_, current_.pkg_, Domain::PKG),
+	                 energyDelta(previous_.pp0_, current_.pp0_, Domain::PP0),
+					 energyDelta(previous_.pp1_, current_.pp1_, Domain::PP1),
+					 energyDelta(previous_.dram_, current_.dram_, Domain::DRAM),
 					 std::chrono::high_resolution_clock::now()); // probably does not matter
 }
 
@@ -103,7 +105,19 @@ RaplState& operator+=(RaplState& left, const RaplState& right) {
 
 void Rapl::initializeRaplForPowerReadingAndCapping()
 {
-    MSR msr(cpuCore_);
+    // PKG and PP0 are always read, the rest only if the platform provides them
+    sampledDomains_ = {Domain::PKG, Domain::PP0};
+    if (availableDomains_.pp1_) sampledDomains_.push_back(Domain::PP1);
+    if (availableDomains_.dram_) sampledDomains_.push_back(Domain::DRAM);
+
+    if (!MSR::isAccessible(cpuCore_))
+    {
+        std::cout << "[INFO] MSR of core " << cpuCore_ << " not accessible, RAPL power info and clamping not available.\n";
+        initializeEnergyReader();
+        return;
+    }
+    msr_ = std::make_unique<MSR>(cpuCore_);
+    auto& msr = *msr_;
 
     power_units  = msr.getUnits(Quantity::Power);
     energy_units = msr.getUnits(Quantity::Energy);
@@ -115,6 +129,7 @@ void Rapl::initializeRaplForPowerReadingAndCapping()
     else {
         dram_energy_units = energy_units;
     }
+    initializeEnergyReader();
 
     auto powerInfo = msr.getPowerInfoForPKG();
     printf("\t\tPackage thermal spec: %.3fW\n", powerInfo.thermalDesignPower);
@@ -134,15 +149,33 @@ void Rapl::initializeRaplForPowerReadingAndCapping()
 
 }
 
-Rapl::Rapl(int core, AvailableRaplPowerDomains avDom) :
-    cpuCore_(core), availableDomains_(avDom)
+void Rapl::initializeEnergyReader()
+{
+    energyReader_ = createEnergyReader(cpuCore_, powercapZoneDir_, msr_.get(), energy_units, dram_energy_units);
+    energy_units = energyReader_->getEnergyUnitInJoules(Domain::PKG);
+    dram_energy_units = energyReader_->getEnergyUnitInJoules(Domain::DRAM);
+    for (auto d : {Domain::PKG, Domain::PP0, Domain::PP1, Domain::DRAM})
+    {
+        extendedCounters_[d].setWrapRange(energyReader_->getWrapRange(d));
+    }
+    // the state sequence is fed with the extended counters
+    rss_.setWrapRanges({0, 0, 0, 0});
+    std::cout << "[INFO] RAPL energy of core " << cpuCore_ << " package read with " << energyReader_->getName() << " backend.\n";
+}
+
+Rapl::Rapl(int core, AvailableRaplPowerDomains avDom, std::string powercapZoneDir) :
+    cpuCore_(core), availableDomains_(avDom), powercapZoneDir_(std::move(powercapZoneDir))
 {
     initializeRaplForPowerReadingAndCapping();
+    rss_.reset();
     reset();
+    // the first increment after creation is counted from the empty state
+	RaplState emptyState;
+    totalResultSinceCreation_ = emptyState;
 }
 
 void Rapl::reset() {
-    rss_.reset();
+    // state sequence is not cleared so that the energy counter stays continuous,
     // sample twice to fill current and previous
     sample();
     sample();
@@ -150,18 +183,81 @@ void Rapl::reset() {
 	totalResultSinceLastReset_ = emptyState;
 }
 
+void Rapl::tick() {
+    energyReader_->read(sampledDomains_, energyStatus_);
+    for (auto d : sampledDomains_)
+    {
+        extendedCounters_[d].update(energyStatus_[d]);
+    }
+}
+
+double Rapl::getWrapPeriodInSeconds(double maxPowerInWatts) const
+{
+    double result = std::numeric_limits<double>::infinity();
+    for (auto d : sampledDomains_)
+    {
+        const auto range = extendedCounters_[d].getWrapRange();
+        if (range)
+        {
+            const double units = d == Domain::DRAM ? dram_energy_units : energy_units;
+            result = std::min(result, range * units / maxPowerInWatts);
+        }
+    }
+    return result;
+}
+
+TimePoint Rapl::waitForCounterUpdate()
+{
+    // counters are updated about every 1 ms, give up if nothing changes within 2 updates
+    static const auto maxWait = std::chrono::microseconds(2000);
+    static const std::vector<Domain> pkgOnly {Domain::PKG};
+    std::array<uint64_t, 4> status {0, 0, 0, 0};
+    energyReader_->read(pkgOnly, status);
+    const auto initial = status[Domain::PKG];
+    auto before = std::chrono::high_resolution_clock::now();
+    const auto deadline = before + maxWait;
+    while (true)
+    {
+        energyReader_->read(pkgOnly, status);
+        const auto after = std::chrono::high_resolution_clock::now();
+        if (status[Domain::PKG] != initial)
+        {
+            // the update happened between the two last reads
+            return before + (after - before) / 2;
+        }
+        if (after > deadline)
+        {
+            return after;
+        }
+        before = after;
+    }
+}
+
 void Rapl::sample() {
-    MSR msr(cpuCore_);
+    TimePoint timestamp;
+    if (alignedSampling_)
+    {
+        timestamp = waitForCounterUpdate();
+        tick();
+    }
+    else
+    {
+        tick();
+        timestamp = std::chrono::high_resolution_clock::now();
+    }
+    lastSampleTime_ = timestamp;
 	RaplState nextState(
-		msr.getEnergyStatus(Domain::PKG),
-		msr.getEnergyStatus(Domain::PP0),
-		availableDomains_.pp1_ ? msr.getEnergyStatus(Domain::PP1) : 0,
-		availableDomains_.dram_ ? msr.getEnergyStatus(Domain::DRAM) : 0,
-		std::chrono::high_resolution_clock::now());
+		extendedCounters_[Domain::PKG].getValue(),
+		extendedCounters_[Domain::PP0].getValue(),
+		extendedCounters_[Domain::PP1].getValue(),
+		extendedCounters_[Domain::DRAM].getValue(),
+		timestamp);
 
     rss_.storeNextState(nextState);
 
-    totalResultSinceLastReset_ += rss_.getCurrentEnergyIncrement();
+    auto energyIncrement = rss_.getCurrentEnergyIncrement();
+    totalResultSinceLastReset_ += energyIncrement;
+    totalResultSinceCreation_ += energyIncrement;
 	rss_.rotateStates();
 }
 
@@ -236,6 +332,25 @@ double Rapl::dram_total_energy() const
     return dram_energy_units * ((double) totalResultSinceLastReset_.dram_);
 }
 
+double Rapl::pkg_energy_counter() const
+{
+    return energy_units * ((double) totalResultSinceCreation_.pkg_);
+}
+
+double Rapl::dram_energy_counter() const
+{
+    return dram_energy_units * ((double) totalResultSinceCreation_.dram_);
+}
+
+void Rapl::getLastEnergyIncrementInJoules(std::array<double, 4>& result) const
+{
+    const auto increment = rss_.getPreviousEnergyIncrement();
+    result[Domain::PKG] = energy_units * ((double) increment.pkg_);
+    result[Domain::PP0] = energy_units * ((double) increment.pp0_);
+    result[Domain::PP1] = energy_units * ((double) increment.pp1_);
+    result[Domain::DRAM] = dram_energy_units * ((double) increment.dram_);
+}
+
 double Rapl::get_total_time() const
 {
     return rss_.getTotalTime(totalResultSinceLastReset_.timeSec_);
@@ -247,7 +362,11 @@ double Rapl::current_time() {
 
 double Rapl::pkg_max_power() const
 {
-    auto&& pkgPowerInfo = MSR(cpuCore_).getPowerInfoForPKG();
+    if (!msr_)
+    {
+        return 0.0;
+    }
+    auto&& pkgPowerInfo = msr_->getPowerInfoForPKG();
     auto&& maxPower = pkgPowerInfo.maxPower;
     return maxPower ? maxPower : pkgPowerInfo.thermalDesignPower;
 }
@@ -0,0 +1,246 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "power_interface/energy_reader.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+static inline std::string readFirstLine(const fs::path& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// ------------------------------------------------------------------------------------------
+// MSR
+// ------------------------------------------------------------------------------------------
+MsrEnergyReader::MsrEnergyReader(MSR& msr, double energyUnits, double dramEnergyUnits) :
+    msr_(msr), energyUnits_(energyUnits), dramEnergyUnits_(dramEnergyUnits)
+{
+}
+
+void MsrEnergyReader::read(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result)
+{
+    msr_.getEnergyStatus(domains, result);
+}
+
+// ------------------------------------------------------------------------------------------
+// powercap sysfs
+// ------------------------------------------------------------------------------------------
+PowercapEnergyReader::PowercapEnergyReader(const std::string& packageZoneDir)
+{
+    const fs::path packageZone(packageZoneDir);
+    openZone(packageZone.string(), Domain::PKG);
+    if (fds_[Domain::PKG] < 0)
+    {
+        throw std::runtime_error("cannot read " + (packageZone / "energy_uj").string());
+    }
+    static const std::map<std::string, Domain> subzoneNames {
+        {"core", Domain::PP0},
+        {"uncore", Domain::PP1},
+        {"dram", Domain::DRAM},
+    };
+    std::error_code ec;
+    for (auto&& entry : fs::directory_iterator(packageZone, ec))
+    {
+        if (!entry.is_directory() || !fs::exists(entry.path() / "name"))
+        {
+            continue;
+        }
+        auto found = subzoneNames.find(readFirstLine(entry.path() / "name"));
+        if (found != subzoneNames.end())
+        {
+            openZone(entry.path().string(), found->second);
+        }
+    }
+}
+
+PowercapEnergyReader::~PowercapEnergyReader()
+{
+    for (auto&& fd : fds_)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
+void PowercapEnergyReader::openZone(const std::string& zoneDir, Domain d)
+{
+    const fs::path zone(zoneDir);
+    int fd = open((zone / "energy_uj").c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+    char buffer[32];
+    if (pread(fd, buffer, sizeof(buffer) - 1, 0) <= 0)
+    {
+        // e.g., energy_uj restricted to root since CVE-2020-8694 mitigation
+        close(fd);
+        return;
+    }
+    fds_[d] = fd;
+    // counter wraps to 0 after reaching max_energy_range_uj
+    const auto range = readFirstLine(zone / "max_energy_range_uj");
+    wrapRanges_[d] = range.empty() ? 0 : std::strtoull(range.c_str(), nullptr, 10) + 1;
+}
+
+void PowercapEnergyReader::read(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result)
+{
+    char buffer[32];
+    for (auto&& d : domains)
+    {
+        result[d] = 0;
+        if (fds_[d] < 0)
+        {
+            continue;
+        }
+        const auto length = pread(fds_[d], buffer, sizeof(buffer) - 1, 0);
+        if (length > 0)
+        {
+            buffer[length] = '\0';
+            result[d] = std::strtoull(buffer, nullptr, 10);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// perf power PMU
+// ------------------------------------------------------------------------------------------
+static inline uint64_t parsePerfEventConfig(const std::string& eventDescription)
+{
+    // format: "event=0x02" (optionally followed by other terms)
+    const auto position = eventDescription.find("event=");
+    if (position == std::string::npos)
+    {
+        return 0;
+    }
+    return std::strtoull(eventDescription.c_str() + position + 6, nullptr, 0);
+}
+
+PerfEnergyReader::PerfEnergyReader(int cpu, const std::string& pmuDir)
+{
+    const fs::path pmu(pmuDir);
+    const auto type = readFirstLine(pmu / "type");
+    if (type.empty())
+    {
+        throw std::runtime_error("perf power PMU not available in " + pmu.string());
+    }
+    static const std::array<std::pair<const char*, Domain>, 4> events {{
+        {"energy-pkg", Domain::PKG},
+        {"energy-cores", Domain::PP0},
+        {"energy-gpu", Domain::PP1},
+        {"energy-ram", Domain::DRAM},
+    }};
+    for (auto&& [name, domain] : events)
+    {
+        const auto description = readFirstLine(pmu / "events" / name);
+        if (description.empty())
+        {
+            continue;
+        }
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = std::strtoul(type.c_str(), nullptr, 10);
+        attr.config = parsePerfEventConfig(description);
+        int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, -1, cpu, -1, PERF_FLAG_FD_CLOEXEC));
+        if (fd < 0)
+        {
+            continue;
+        }
+        fds_[domain] = fd;
+        const auto scale = readFirstLine(pmu / "events" / (std::string(name) + ".scale"));
+        scales_[domain] = scale.empty() ? 1.0 : std::strtod(scale.c_str(), nullptr);
+    }
+    if (fds_[Domain::PKG] < 0)
+    {
+        throw std::runtime_error("cannot open energy-pkg perf event for CPU " + std::to_string(cpu) +
+                                 ": " + std::strerror(errno));
+    }
+}
+
+PerfEnergyReader::~PerfEnergyReader()
+{
+    for (auto&& fd : fds_)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
+void PerfEnergyReader::read(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result)
+{
+    for (auto&& d : domains)
+    {
+        result[d] = 0;
+        if (fds_[d] >= 0 && ::read(fds_[d], &result[d], sizeof(uint64_t)) != sizeof(uint64_t))
+        {
+            result[d] = 0;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+std::unique_ptr<EnergyReader> createEnergyReader(
+    int cpu,
+    const std::string& powercapPackageZoneDir,
+    MSR* msr,
+    double msrEnergyUnits,
+    double msrDramEnergyUnits)
+{
+    if (msr)
+    {
+        return std::make_unique<MsrEnergyReader>(*msr, msrEnergyUnits, msrDramEnergyUnits);
+    }
+    try
+    {
+        return std::make_unique<PowercapEnergyReader>(powercapPackageZoneDir);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "[INFO] powercap energy reader not available: " << e.what() << "\n";
+    }
+    try
+    {
+        return std::make_unique<PerfEnergyReader>(cpu);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << "[INFO] perf energy reader not available: " << e.what() << "\n";
+    }
+    throw std::runtime_error("no RAPL energy reader available for CPU " + std::to_string(cpu) +
+                             " (tried msr, powercap and perf)");
+}
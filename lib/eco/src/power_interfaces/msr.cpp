@@ -31,6 +31,17 @@ MSR::~MSR() {
     }
 }
 
+bool MSR::isAccessible(int core) {
+    std::stringstream filenameStream;
+    filenameStream << "/dev/cpu/" << core << "/msr";
+    int fd = open(filenameStream.str().c_str(), O_RDWR);
+    if (fd < 0) {
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
 void MSR::openMSR(int core) {
     std::stringstream filenameStream;
     filenameStream << "/dev/cpu/" << core << "/msr";
@@ -87,6 +98,12 @@ uint64_t MSR::getEnergyStatus(Domain domain) {
     }
 }
 
+void MSR::getEnergyStatus(const std::vector<Domain>& domains, std::array<uint64_t, 4>& result) {
+    for (auto&& domain : domains) {
+        result[domain] = getEnergyStatus(domain);
+    }
+}
+
 double MSR::getUnits(Quantity q) {
     uint64_t rawValue = readMSR(MSR_RAPL_POWER_UNIT);
 	switch (q) {
@@ -0,0 +1,103 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "power_interface/rapl_series_store.hpp"
+
+#include <algorithm>
+
+RaplSeriesStore::RaplSeriesStore(std::size_t numPackages, std::size_t capacity) :
+    numPackages_(numPackages),
+    capacity_(capacity),
+    energyColumns_(numPackages * NUM_RAPL_DOMAINS, std::vector<double>(capacity, 0.0)),
+    timestamps_(capacity),
+    totalEnergy_(numPackages * NUM_RAPL_DOMAINS, 0.0),
+    currentPower_(numPackages * NUM_RAPL_DOMAINS, 0.0)
+{
+}
+
+void RaplSeriesStore::appendSample(TimePoint timestamp, const std::vector<std::array<double, NUM_RAPL_DOMAINS>>& energyIncrements)
+{
+    const double timeDelta = hasLastTimestamp_ ? std::chrono::duration<double>(timestamp - lastTimestamp_).count() : 0.0;
+    for (std::size_t pkg = 0; pkg < numPackages_ && pkg < energyIncrements.size(); pkg++)
+    {
+        for (std::size_t d = 0; d < NUM_RAPL_DOMAINS; d++)
+        {
+            const auto column = pkg * NUM_RAPL_DOMAINS + d;
+            const auto increment = energyIncrements[pkg][d];
+            energyColumns_[column][head_] = increment;
+            totalEnergy_[column] += increment;
+            if (timeDelta > 0.0)
+            {
+                currentPower_[column] = increment / timeDelta;
+            }
+        }
+    }
+    timestamps_[head_] = timestamp;
+    head_ = (head_ + 1) % capacity_;
+    size_ = size_ < capacity_ ? size_ + 1 : capacity_;
+    lastTimestamp_ = timestamp;
+    hasLastTimestamp_ = true;
+}
+
+void RaplSeriesStore::reset()
+{
+    head_ = 0;
+    size_ = 0;
+    std::fill(totalEnergy_.begin(), totalEnergy_.end(), 0.0);
+    // the first sample after the reset must not be divided by the time since the last one before it
+    lastTimestamp_ = {};
+    hasLastTimestamp_ = false;
+}
+
+double RaplSeriesStore::getTotalEnergy(Domain d) const
+{
+    double result = 0.0;
+    for (std::size_t pkg = 0; pkg < numPackages_; pkg++)
+    {
+        result += totalEnergy_[columnIndex(pkg, d)];
+    }
+    return result;
+}
+
+std::vector<double> RaplSeriesStore::getTotalEnergyPerPackage(Domain d) const
+{
+    std::vector<double> result(numPackages_);
+    for (std::size_t pkg = 0; pkg < numPackages_; pkg++)
+    {
+        result[pkg] = totalEnergy_[columnIndex(pkg, d)];
+    }
+    return result;
+}
+
+double RaplSeriesStore::getCurrentPower(Domain d) const
+{
+    double result = 0.0;
+    for (std::size_t pkg = 0; pkg < numPackages_; pkg++)
+    {
+        result += currentPower_[columnIndex(pkg, d)];
+    }
+    return result;
+}
+
+double RaplSeriesStore::getEnergyIncrementAt(std::size_t pkg, Domain d, std::size_t i) const
+{
+    return energyColumns_[columnIndex(pkg, d)][rowIndex(i)];
+}
+
+TimePoint RaplSeriesStore::getTimestampAt(std::size_t i) const
+{
+    return timestamps_[rowIndex(i)];
+}
@@ -0,0 +1,168 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "sampler.hpp"
+
+#include <cerrno>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+static constexpr long NANOSECONDS_IN_SECOND {1000000000L};
+static constexpr long MAX_SLEEP_SLICE_IN_MICROSECONDS {50000L};
+
+static inline void addMicroSeconds(timespec& ts, long us)
+{
+    ts.tv_nsec += us * 1000L;
+    while (ts.tv_nsec >= NANOSECONDS_IN_SECOND)
+    {
+        ts.tv_nsec -= NANOSECONDS_IN_SECOND;
+        ts.tv_sec++;
+    }
+}
+
+static inline bool isEarlier(const timespec& left, const timespec& right)
+{
+    return left.tv_sec < right.tv_sec || (left.tv_sec == right.tv_sec && left.tv_nsec < right.tv_nsec);
+}
+
+Sampler::Sampler(Probe probe, int periodInMicroSeconds, bool realTimePriority, std::size_t ringCapacity) :
+    probe_(std::move(probe)),
+    periodInMicroSeconds_(periodInMicroSeconds),
+    realTimePriority_(realTimePriority),
+    ring_(ringCapacity)
+{
+}
+
+Sampler::~Sampler()
+{
+    stop();
+}
+
+void Sampler::start()
+{
+    if (running_.exchange(true))
+    {
+        return;
+    }
+    thread_ = std::thread(&Sampler::samplingLoop, this);
+}
+
+void Sampler::stop()
+{
+    running_.store(false);
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+void Sampler::trySetRealTimePriority()
+{
+    sched_param param {};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+    {
+        std::cerr << "[WARNING] Sampler: cannot set SCHED_FIFO priority, sampling with default scheduling policy.\n";
+    }
+}
+
+void Sampler::samplingLoop()
+{
+    if (realTimePriority_)
+    {
+        trySetRealTimePriority();
+    }
+    timespec lastDeadline;
+    clock_gettime(CLOCK_MONOTONIC, &lastDeadline);
+    while (running_.load())
+    {
+        timespec deadline = lastDeadline;
+        addMicroSeconds(deadline, periodInMicroSeconds_.load());
+        // long periods are slept in bounded slices and the deadline is recomputed
+        // after each of them, so that shortening the period or stopping the sampler
+        // takes effect without waiting for the long deadline to expire
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        while (running_.load() && isEarlier(now, deadline))
+        {
+            timespec wakeUp = now;
+            addMicroSeconds(wakeUp, MAX_SLEEP_SLICE_IN_MICROSECONDS);
+            if (isEarlier(deadline, wakeUp))
+            {
+                wakeUp = deadline;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUp, nullptr);
+            deadline = lastDeadline;
+            addMicroSeconds(deadline, periodInMicroSeconds_.load());
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if (isEarlier(deadline, now))
+            {
+                // period shortened below the time already waited
+                deadline = now;
+            }
+        }
+        if (!running_.load())
+        {
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(probeMutex_);
+            if (!ring_.push(probe_()))
+            {
+                droppedSamples_++;
+            }
+        }
+        lastDeadline = deadline;
+        // if sampling took longer than the period skip the missed deadlines
+        // instead of trying to catch up with a burst of samples
+        timespec nextDeadline = deadline;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        addMicroSeconds(nextDeadline, periodInMicroSeconds_.load());
+        if (isEarlier(nextDeadline, now))
+        {
+            overruns_++;
+            lastDeadline = now;
+        }
+    }
+}
+
+PowerAndPerfState Sampler::waitForNextSample()
+{
+    PowerAndPerfState state(0.0, 0, TimePoint());
+    // the consumer polls in slices much shorter than the sampling period,
+    // the sample timestamps are not affected by the polling latency
+    const timespec pollSlice {0, 100000L}; // 100 us
+    while (!ring_.pop(state))
+    {
+        if (!running_.load())
+        {
+            std::lock_guard<std::mutex> lock(probeMutex_);
+            return probe_();
+        }
+        nanosleep(&pollSlice, nullptr);
+    }
+    return state;
+}
+
+void Sampler::dropPendingSamples()
+{
+    PowerAndPerfState state(0.0, 0, TimePoint());
+    while (ring_.pop(state))
+    {
+    }
+}
@@ -0,0 +1,190 @@
+/*
+   Copyright 2026, Adam Krzywaniak.
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "tuning_cache.hpp"
+
+#include <yaml-cpp/yaml.h>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+static constexpr uint64_t FNV_OFFSET_BASIS {14695981039346656037ULL};
+static constexpr uint64_t FNV_PRIME {1099511628211ULL};
+
+static inline uint64_t fnv1a(const char* data, std::size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static inline std::string toHex(uint64_t value)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << value;
+    return ss.str();
+}
+
+static std::string resolveExecutable(const std::string& command)
+{
+    if (command.find('/') != std::string::npos)
+    {
+        return command;
+    }
+    const char* path = std::getenv("PATH");
+    std::stringstream dirs(path ? path : "");
+    std::string dir;
+    while (std::getline(dirs, dir, ':'))
+    {
+        const auto candidate = (dir.empty() ? "." : dir) + "/" + command;
+        if (access(candidate.c_str(), X_OK) == 0)
+        {
+            return candidate;
+        }
+    }
+    return command;
+}
+
+TuningCache::TuningCache(std::string fileName) :
+    fileName_(std::move(fileName))
+{
+    load();
+}
+
+std::string TuningCache::hashExecutable(const std::string& command)
+{
+    std::ifstream file(resolveExecutable(command), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        return "";
+    }
+    uint64_t hash = FNV_OFFSET_BASIS;
+    char buffer[1 << 16];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount())
+    {
+        hash = fnv1a(buffer, file.gcount(), hash);
+    }
+    return toHex(hash);
+}
+
+std::string TuningCache::makeKey(
+    char* const* argv,
+    const std::string& deviceName,
+    TargetMetric metric,
+    TuningCacheEntry& entry)
+{
+    std::stringstream command;
+    for (int i = 1; argv[i]; i++)
+    {
+        command << (i > 1 ? " " : "") << argv[i];
+    }
+    std::stringstream metricName;
+    metricName << metric;
+    entry.command_ = command.str();
+    entry.binaryHash_ = argv[1] ? hashExecutable(argv[1]) : "";
+    entry.device_ = deviceName;
+    entry.metric_ = metricName.str();
+
+    const auto fingerprint = entry.command_ + "\n" + entry.binaryHash_ + "\n" + entry.device_ + "\n" + entry.metric_;
+    return toHex(fnv1a(fingerprint.data(), fingerprint.size()));
+}
+
+std::optional<TuningCacheEntry> TuningCache::find(const std::string& key) const
+{
+    auto found = entries_.find(key);
+    if (found == entries_.end())
+    {
+        return std::nullopt;
+    }
+    return found->second;
+}
+
+void TuningCache::store(const std::string& key, const TuningCacheEntry& entry)
+{
+    entries_[key] = entry;
+    save();
+}
+
+void TuningCache::load()
+{
+    std::ifstream file(fileName_);
+    if (!file.is_open())
+    {
+        return;
+    }
+    try
+    {
+        YAML::Node root = YAML::Load(file);
+        for (auto&& item : root)
+        {
+            const auto& node = item.second;
+            TuningCacheEntry entry;
+            entry.command_ = node["command"].as<std::string>();
+            entry.binaryHash_ = node["binaryHash"].as<std::string>();
+            entry.device_ = node["device"].as<std::string>();
+            entry.metric_ = node["metric"].as<std::string>();
+            entry.capInWatts_ = node["capInWatts"].as<double>();
+            entry.relativeCost_ = node["relativeCost"].as<double>();
+            for (auto&& point : node["curve"])
+            {
+                entry.curve_.emplace_back(point[0].as<double>(), point[1].as<double>());
+            }
+            entries_[item.first.as<std::string>()] = entry;
+        }
+    }
+    catch (const YAML::Exception& e)
+    {
+        std::cerr << "[WARNING] Ignoring malformed tuning cache " << fileName_ << ": " << e.what() << "\n";
+        entries_.clear();
+    }
+}
+
+void TuningCache::save() const
+{
+    YAML::Emitter out;
+    out << YAML::BeginMap;
+    for (auto&& [key, entry] : entries_)
+    {
+        out << YAML::Key << key << YAML::Value << YAML::BeginMap
+            << YAML::Key << "command" << YAML::Value << entry.command_
+            << YAML::Key << "binaryHash" << YAML::Value << entry.binaryHash_
+            << YAML::Key << "device" << YAML::Value << entry.device_
+            << YAML::Key << "metric" << YAML::Value << entry.metric_
+            << YAML::Key << "capInWatts" << YAML::Value << entry.capInWatts_
+            << YAML::Key << "relativeCost" << YAML::Value << entry.relativeCost_
+            << YAML::Key << "curve" << YAML::Value << YAML::BeginSeq;
+        for (auto&& [cap, cost] : entry.curve_)
+        {
+            out << YAML::Flow << YAML::BeginSeq << cap << cost << YAML::EndSeq;
+        }
+        out << YAML::EndSeq << YAML::EndMap;
+    }
+    out << YAML::EndMap;
+    std::ofstream file(fileName_, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "[WARNING] Cannot write tuning cache " << fileName_ << "\n";
+        return;
+    }
+    file << out.c_str() << "\n";
+}
@@ -0,0 +1,427 @@
+#include "data_structures/cusum_detector.hpp"
+#include "data_structures/measurement_cache.hpp"
+#include "data_structures/periodicity_detector.hpp"
+#include "data_structures/sequential_probability_ratio_test.hpp"
+#include "data_structures/stability_detector.hpp"
+#include "data_structures/window_calibrator.hpp"
+#include "../src/logging.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+#define CHECK(x)                                                                                                       \
+    if (x != true)                                                                                                     \
+    {                                                                                                                  \
+        exit(-1);                                                                                                      \
+    }
+
+// Box-Muller on the raw generator output, so the sequence does not depend on the standard library
+static double gaussian(std::mt19937& generator)
+{
+    const double u1 = (generator() + 0.5) / 4294967296.0;
+    const double u2 = (generator() + 0.5) / 4294967296.0;
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+bool test_cusum_false_alarms()
+{
+    // stationary noisy signal, e.g., instructions per second of a steady application
+    int alarms = 0;
+    for (unsigned seed = 1; seed <= 50; seed++)
+    {
+        std::mt19937 generator(seed);
+        CusumDetector detector;
+        for (int i = 0; i < 2000; i++)
+        {
+            if (detector.update(100.0 + 5.0 * gaussian(generator)))
+            {
+                alarms++;
+                detector.restart();
+            }
+        }
+    }
+    if (alarms > 5)
+    {
+        LOG_ERROR("{} false alarms in 100k stationary samples", alarms);
+        return false;
+    }
+    return true;
+}
+
+bool test_cusum_detects_shift()
+{
+    std::mt19937 generator(7);
+    CusumDetector detector;
+    for (int i = 0; i < 500; i++)
+    {
+        if (detector.update(100.0 + 5.0 * gaussian(generator)))
+        {
+            LOG_ERROR("False alarm at sample {} before the shift", i);
+            return false;
+        }
+    }
+    // the application moves to a phase with 10% lower rate, i.e., 2 standard deviations
+    int delay = 0;
+    while (!detector.update(90.0 + 5.0 * gaussian(generator)))
+    {
+        if (++delay > 40)
+        {
+            LOG_ERROR("Shift by 2 standard deviations not detected within 40 samples");
+            return false;
+        }
+    }
+    // after the restart the new phase is the baseline
+    detector.restart();
+    for (int i = 0; i < 500; i++)
+    {
+        if (detector.update(90.0 + 5.0 * gaussian(generator)))
+        {
+            LOG_ERROR("False alarm at sample {} after the restart", i);
+            return false;
+        }
+    }
+    return detector.isChangeDetected() == false && detector.isLearningBaseline() == false;
+}
+
+bool test_cusum_ignores_negligible_shift_of_constant_signal()
+{
+    // no noise at all, the standard deviation is floored at 1% of the mean
+    CusumDetector detector;
+    for (int i = 0; i < 1000; i++)
+    {
+        if (detector.update(i < 100 ? 50.0 : 50.1))
+        {
+            LOG_ERROR("Alarm on a 0.2% shift of a constant signal at sample {}", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_periodicity_of_noisy_sine()
+{
+    std::mt19937 generator(3);
+    PeriodicityDetector detector;
+    for (int i = 0; i < 1000; i++)
+    {
+        detector.append(100.0 + 10.0 * std::sin(2.0 * M_PI * i * 0.1 / 2.5) + 3.0 * gaussian(generator), 0.1);
+    }
+    const double period = detector.estimatePeriodInSeconds();
+    if (std::abs(period - 2.5) > 0.025)
+    {
+        LOG_ERROR("Expected the period of 2.5 s, but got {}", period);
+        return false;
+    }
+    return true;
+}
+
+bool test_periodicity_of_iterations_with_trend()
+{
+    // 1.5 s of compute and 0.5 s of communication per iteration, slowly heating up
+    std::mt19937 generator(4);
+    PeriodicityDetector detector;
+    for (int i = 0; i < 1200; i++)
+    {
+        const double phase = std::fmod(i * 0.05, 2.0);
+        detector.append((phase < 1.5 ? 150.0 : 60.0) + 0.01 * i + 5.0 * gaussian(generator), 0.05);
+    }
+    const double period = detector.estimatePeriodInSeconds();
+    if (std::abs(period - 2.0) > 0.02)
+    {
+        LOG_ERROR("Expected the period of 2 s, but got {}", period);
+        return false;
+    }
+    return true;
+}
+
+bool test_periodicity_absent()
+{
+    std::mt19937 generator(5);
+    PeriodicityDetector noise;
+    for (int i = 0; i < 1000; i++)
+    {
+        noise.append(100.0 + 5.0 * gaussian(generator), 0.1);
+    }
+    PeriodicityDetector tooShort;
+    for (int i = 0; i < 10; i++)
+    {
+        tooShort.append(std::sin(i), 0.1);
+    }
+    const double noisePeriod = noise.estimatePeriodInSeconds();
+    const double shortPeriod = tooShort.estimatePeriodInSeconds();
+    if (noisePeriod != 0.0 || shortPeriod != 0.0)
+    {
+        LOG_ERROR("Expected no period, but got {} for noise and {} for too few samples", noisePeriod, shortPeriod);
+        return false;
+    }
+    return true;
+}
+
+// number of samples after which the detector first reports stability, -1 if never
+template <class Signal>
+static int samples_until_stable(StabilityDetector& detector, Signal&& signal, int maxSamples)
+{
+    for (int i = 0; i < maxSamples; i++)
+    {
+        detector.append(signal(i));
+        if (detector.isStable())
+        {
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+bool test_stability_of_clean_and_noisy_signals()
+{
+    StabilityDetector clean;
+    const int cleanSamples = samples_until_stable(clean, [](int i) { return 100.0 + 0.1 * std::sin(i); }, 300);
+    // noise larger than the tolerance band, accepted by the equivalence test before the window is full
+    std::mt19937 generator(11);
+    StabilityDetector noisy;
+    const int noisySamples = samples_until_stable(noisy, [&](int) { return 100.0 + 5.0 * gaussian(generator); }, 300);
+    if (cleanSamples < 0 || cleanSamples > 10 || noisySamples < 0 || noisySamples >= 200)
+    {
+        LOG_ERROR("Stability declared after {} clean and {} noisy samples", cleanSamples, noisySamples);
+        return false;
+    }
+    return true;
+}
+
+bool test_stability_after_start_up_ramp()
+{
+    std::mt19937 generator(12);
+    StabilityDetector detector;
+    for (int i = 0; i < 100; i++)
+    {
+        detector.append(50.0 + i + 2.0 * gaussian(generator));
+        if (detector.isStable())
+        {
+            LOG_ERROR("Ramp declared stable at sample {}", i);
+            return false;
+        }
+    }
+    // samples of the ramp are dropped with the older half instead of waiting for a full window
+    const int samples = samples_until_stable(detector, [&](int) { return 150.0 + 2.0 * gaussian(generator); }, 300);
+    if (samples < 0 || samples > 60)
+    {
+        LOG_ERROR("Stability after the ramp declared after {} samples", samples);
+        return false;
+    }
+    return true;
+}
+
+bool test_stability_lost_on_step()
+{
+    std::mt19937 generator(9);
+    StabilityDetector detector;
+    for (int i = 0; i < 200; i++)
+    {
+        detector.append(100.0 + gaussian(generator));
+    }
+    if (!detector.isStable())
+    {
+        LOG_ERROR("Steady signal not stable");
+        return false;
+    }
+    int unstableAfter = -1;
+    for (int i = 0; i < 200; i++)
+    {
+        detector.append(130.0 + gaussian(generator));
+        if (unstableAfter < 0 && !detector.isStable())
+        {
+            unstableAfter = i + 1;
+        }
+    }
+    if (unstableAfter < 0 || unstableAfter > 10 || !detector.isStable())
+    {
+        LOG_ERROR("Step by 30% detected after {} samples, stable at the end: {}", unstableAfter, detector.isStable());
+        return false;
+    }
+    return true;
+}
+
+// 100 ms sample of the given energy per instruction with the log-normal noise
+static PowAndPerfResult make_sample(double capInWatts, double energyPerInstruction, double logNoise)
+{
+    const double instructions = 1e8;
+    const double energy = energyPerInstruction * std::exp(logNoise) * instructions;
+    return PowAndPerfResult(instructions, 0.1, capInWatts, energy, energy / 0.1, 0.0, energy / 0.1);
+}
+
+static bool is_close(double value, double expected, double relativeTolerance)
+{
+    return std::abs(value - expected) <= relativeTolerance * expected;
+}
+
+bool test_window_calibration_of_independent_samples()
+{
+    // 10% noise per sample and 1% target error need 100 samples, i.e., 10 s
+    std::mt19937 generator(1);
+    WindowCalibrator single(0.01);
+    for (int i = 0; i < 2000; i++)
+    {
+        single.append(make_sample(100.0, 1e-8, 0.1 * gaussian(generator)));
+    }
+    // the levels of different caps are not the noise
+    WindowCalibrator segmented(0.01);
+    for (int i = 0; i < 2000; i++)
+    {
+        const int segment = i / 200;
+        segmented.append(make_sample(60.0 + 10.0 * segment, (1.0 + 0.3 * segment) * 1e-8, 0.1 * gaussian(generator)));
+    }
+    const auto singleWindow = single.getWindowInSeconds();
+    const auto segmentedWindow = segmented.getWindowInSeconds();
+    if (!singleWindow || !segmentedWindow || !is_close(*singleWindow, 10.0, 0.1) || !is_close(*segmentedWindow, 10.0, 0.1))
+    {
+        LOG_ERROR("Expected 10 s windows, but got {} and {} s", singleWindow.value_or(-1.0), segmentedWindow.value_or(-1.0));
+        return false;
+    }
+    return true;
+}
+
+bool test_window_calibration_of_autocorrelated_samples()
+{
+    // AR(1) noise with rho 0.5 triples the number of samples
+    std::mt19937 generator(3);
+    WindowCalibrator calibrator(0.01);
+    double noise = 0.0;
+    for (int i = 0; i < 4000; i++)
+    {
+        noise = 0.5 * noise + std::sqrt(0.75) * 0.1 * gaussian(generator);
+        calibrator.append(make_sample(100.0, 1e-8, noise));
+    }
+    const auto window = calibrator.getWindowInSeconds();
+    if (!window || !is_close(*window, 30.0, 0.15))
+    {
+        LOG_ERROR("Expected 30 s window, but got {} s", window.value_or(-1.0));
+        return false;
+    }
+    return true;
+}
+
+bool test_window_calibration_needs_samples()
+{
+    std::mt19937 generator(4);
+    WindowCalibrator calibrator(0.01);
+    for (int i = 0; i < 29; i++)
+    {
+        calibrator.append(make_sample(100.0, 1e-8, 0.1 * gaussian(generator)));
+    }
+    if (calibrator.getWindowInSeconds())
+    {
+        LOG_ERROR("Window calibrated from 29 samples");
+        return false;
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        calibrator.append(make_sample(100.0, 1e-8, 0.1 * gaussian(generator)));
+    }
+    const bool calibrated = calibrator.getWindowInSeconds().has_value();
+    calibrator.reset();
+    if (!calibrated || calibrator.getWindowInSeconds())
+    {
+        LOG_ERROR("Unexpected calibration state before ({}) or after the reset", calibrated);
+        return false;
+    }
+    return true;
+}
+
+// runs the test over 10 ms samples with 20% noise of the instructions count, returns
+// the number of samples after which the candidate was dominated or -1
+static int samples_until_dominated(double relativeEnergy, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    SequentialProbabilityRatioTest test(1.0, 0.05);
+    double instructions = 0.0, energy = 0.0;
+    for (int i = 0; i < 120; i++)
+    {
+        const double sampleInstructions = 1e7 * std::max(0.2, 1.0 + 0.2 * gaussian(generator));
+        const double sampleEnergy = 0.5 * relativeEnergy * (1.0 + 0.02 * gaussian(generator));
+        instructions += sampleInstructions;
+        energy += sampleEnergy;
+        // costs relative to the incumbent's energy per instruction, 0.5 J per 1e7
+        if (test.update((sampleEnergy / sampleInstructions) / 5e-8, (energy / instructions) / 5e-8))
+        {
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+bool test_sprt_does_not_drop_equal_candidates()
+{
+    // the mean of the per-sample ratios is ~4% above the incumbent's ratio of sums
+    int dropped = 0;
+    for (unsigned seed = 1; seed <= 40; seed++)
+    {
+        dropped += samples_until_dominated(1.0, seed) >= 0;
+    }
+    if (dropped > 1)
+    {
+        LOG_ERROR("{} of 40 candidates equal to the incumbent dropped", dropped);
+        return false;
+    }
+    return true;
+}
+
+bool test_sprt_drops_dominated_candidates()
+{
+    for (unsigned seed = 1; seed <= 20; seed++)
+    {
+        const int samples = samples_until_dominated(1.2, seed);
+        if (samples < 0)
+        {
+            LOG_ERROR("Candidate worse by 20% not dropped (seed {})", seed);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_measurement_cache_keeps_raw_windows()
+{
+    MeasurementCache cache(300.0);
+    const auto now = MeasurementCache::Clock::now();
+    // the older window counts half, the estimate is the window of the weighted sums
+    cache.add(100000000, PowAndPerfResult(1e9, 1.0, 100.0, 50.0, 50.0, 0.0, 50.0), now - std::chrono::seconds(300));
+    cache.add(100000000, PowAndPerfResult(1e9, 1.0, 100.0, 60.0, 60.0, 0.0, 60.0), now);
+    const auto estimate = cache.getEstimate(100000000, now);
+    if (!estimate || !is_close(estimate->getEnergyPerInstr(), 85.0 / 1.5e9, 1e-9) ||
+        !is_close(estimate->getInstrPerSecond(), 1e9, 1e-9) || cache.getEstimate(90000000, now))
+    {
+        LOG_ERROR("Unexpected estimate of the cached windows");
+        return false;
+    }
+    cache.clear();
+    if (!cache.isEmpty() || cache.getEstimate(100000000, now))
+    {
+        LOG_ERROR("Measurements kept after clear()");
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    LOAD_ENV_LEVELS()
+
+    CHECK(test_cusum_false_alarms());
+    CHECK(test_cusum_detects_shift());
+    CHECK(test_cusum_ignores_negligible_shift_of_constant_signal());
+    CHECK(test_periodicity_of_noisy_sine());
+    CHECK(test_periodicity_of_iterations_with_trend());
+    CHECK(test_periodicity_absent());
+    CHECK(test_sprt_does_not_drop_equal_candidates());
+    CHECK(test_sprt_drops_dominated_candidates());
+    CHECK(test_stability_of_clean_and_noisy_signals());
+    CHECK(test_stability_after_start_up_ramp());
+    CHECK(test_stability_lost_on_step());
+    CHECK(test_window_calibration_of_independent_samples());
+    CHECK(test_window_calibration_of_autocorrelated_samples());
+    CHECK(test_window_calibration_needs_samples());
+    CHECK(test_measurement_cache_keeps_raw_windows());
+
+    return 0;
+}
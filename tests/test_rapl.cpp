@@ -0,0 +1,247 @@
+#include "power_interface/energy_reader.hpp"
+#include "power_interface/Rapl.hpp"
+#include "power_interface/extended_energy_counter.hpp"
+#include "power_interface/rapl_series_store.hpp"
+#include "../src/logging.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#define CHECK(x)                                                                                                       \
+    if (x != true)                                                                                                     \
+    {                                                                                                                  \
+        exit(-1);                                                                                                      \
+    }
+
+namespace fs = std::filesystem;
+
+static void write_file(const fs::path& path, const std::string& content)
+{
+    std::ofstream(path) << content << "\n";
+}
+
+static void write_zone(const fs::path& zone, const std::string& name, uint64_t energy, uint64_t maxRange)
+{
+    fs::create_directories(zone);
+    write_file(zone / "name", name);
+    write_file(zone / "energy_uj", std::to_string(energy));
+    write_file(zone / "max_energy_range_uj", std::to_string(maxRange));
+}
+
+// Fake powercap tree of a single package with core and dram subzones (no uncore)
+static fs::path make_fake_powercap_tree()
+{
+    auto root = fs::temp_directory_path() / ("eco_test_rapl_" + std::to_string(getpid()));
+    fs::remove_all(root);
+    auto pkg = root / "intel-rapl:0";
+    write_zone(pkg, "package-0", 123456789, 262143328850);
+    write_zone(pkg / "intel-rapl:0:0", "core", 4242, 262143328850);
+    write_zone(pkg / "intel-rapl:0:1", "dram", 777, 65712999613);
+    return root;
+}
+
+bool test_powercap_reader_domains(const fs::path& root)
+{
+    PowercapEnergyReader reader((root / "intel-rapl:0").string());
+
+    if (!reader.isDomainAvailable(Domain::PKG) || !reader.isDomainAvailable(Domain::PP0) ||
+        !reader.isDomainAvailable(Domain::DRAM) || reader.isDomainAvailable(Domain::PP1))
+    {
+        LOG_ERROR("Unexpected domain mapping of powercap subzones");
+        return false;
+    }
+
+    std::array<uint64_t, 4> values {1, 1, 1, 1};
+    reader.read({Domain::PKG, Domain::PP0, Domain::PP1, Domain::DRAM}, values);
+    if (values[Domain::PKG] != 123456789 || values[Domain::PP0] != 4242 || values[Domain::PP1] != 0 ||
+        values[Domain::DRAM] != 777)
+    {
+        LOG_ERROR("Unexpected counter values: {} {} {} {}", values[0], values[1], values[2], values[3]);
+        return false;
+    }
+
+    if (reader.getEnergyUnitInJoules(Domain::PKG) != 1e-6 || reader.getWrapRange(Domain::PKG) != 262143328851 ||
+        reader.getWrapRange(Domain::DRAM) != 65712999614)
+    {
+        LOG_ERROR("Unexpected units or wrap range");
+        return false;
+    }
+
+    // counters are re-read from the already opened files
+    write_file(root / "intel-rapl:0" / "energy_uj", "123999999");
+    reader.read({Domain::PKG}, values);
+    if (values[Domain::PKG] != 123999999)
+    {
+        LOG_ERROR("Expected updated counter 123999999, but got {}", values[Domain::PKG]);
+        return false;
+    }
+    return true;
+}
+
+bool test_powercap_reader_missing_package(const fs::path& root)
+{
+    try
+    {
+        PowercapEnergyReader reader((root / "intel-rapl:7").string());
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    LOG_ERROR("Expected exception for missing package zone");
+    return false;
+}
+
+bool test_perf_reader_missing_pmu(const fs::path& root)
+{
+    try
+    {
+        PerfEnergyReader reader(0, (root / "no_power_pmu").string());
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    LOG_ERROR("Expected exception for missing perf power PMU");
+    return false;
+}
+
+bool test_state_sequence_wrap_ranges()
+{
+    RaplStateSequence rss;
+    rss.setWrapRanges({1000, uint64_t(1) << 32, 0, 1000});
+    RaplState before(990, 10, 10, 500, TimePoint());
+    RaplState after(5, 20, 20, 600, TimePoint());
+    rss.storeNextState(before);
+    rss.rotateStates();
+    rss.storeNextState(after);
+
+    auto increment = rss.getCurrentEnergyIncrement();
+    if (increment.pkg_ != 15 || increment.pp0_ != 10 || increment.pp1_ != 10 || increment.dram_ != 100)
+    {
+        LOG_ERROR("Unexpected energy increments: {} {} {} {}",
+                  increment.pkg_, increment.pp0_, increment.pp1_, increment.dram_);
+        return false;
+    }
+    return true;
+}
+
+bool test_extended_counter_synthetic_wraps()
+{
+    // 32-bit counter advancing by 3e9 units per tick wraps on almost every tick
+    ExtendedEnergyCounter counter;
+    const uint64_t wrap  = uint64_t(1) << 32;
+    const uint64_t step  = 3000000000ULL;
+    uint64_t       raw   = wrap - 100;
+    counter.update(raw);
+    for (int i = 1; i <= 1000; i++)
+    {
+        raw = (raw + step) % wrap;
+        if (counter.update(raw) != step * i)
+        {
+            LOG_ERROR("Tick {}: expected {}, but got {}", i, step * i, counter.getValue());
+            return false;
+        }
+    }
+
+    // powercap-like range, wrap exactly at the boundary and to 0
+    ExtendedEnergyCounter powercap;
+    powercap.setWrapRange(1000);
+    const std::vector<uint64_t> sequence {998, 999, 0, 1, 500, 999, 10, 10};
+    const std::vector<uint64_t> expected {0, 1, 2, 3, 502, 1001, 1012, 1012};
+    for (std::size_t i = 0; i < sequence.size(); i++)
+    {
+        if (powercap.update(sequence[i]) != expected[i])
+        {
+            LOG_ERROR("Step {}: expected {}, but got {}", i, expected[i], powercap.getValue());
+            return false;
+        }
+    }
+
+    // full 64-bit range of perf counters
+    ExtendedEnergyCounter perf;
+    perf.setWrapRange(0);
+    perf.update(UINT64_MAX - 4);
+    if (perf.update(5) != 10)
+    {
+        LOG_ERROR("Expected 10 after 64-bit wrap, but got {}", perf.getValue());
+        return false;
+    }
+    return true;
+}
+
+bool test_extended_counter_beyond_32_bits()
+{
+    // extended value keeps growing past 2^32 while the state sequence sees no wrap
+    ExtendedEnergyCounter counter;
+    RaplStateSequence     rss;
+    rss.setWrapRanges({0, 0, 0, 0});
+    const uint64_t wrap = uint64_t(1) << 32;
+    uint64_t       raw  = 0;
+    counter.update(raw);
+    RaplState previous(counter.getValue(), 0, 0, 0, TimePoint());
+    uint64_t  total = 0;
+    for (int i = 0; i < 64; i++)
+    {
+        // four ticks of the guard between two samples, each close to a full wrap
+        for (int t = 0; t < 4; t++)
+        {
+            raw = (raw + wrap - 1) % wrap;
+            counter.update(raw);
+        }
+        RaplState next(counter.getValue(), 0, 0, 0, TimePoint());
+        rss.storeNextState(previous);
+        rss.rotateStates();
+        rss.storeNextState(next);
+        total += rss.getCurrentEnergyIncrement().pkg_;
+        previous = next;
+    }
+    if (total != uint64_t(64) * 4 * (wrap - 1))
+    {
+        LOG_ERROR("Expected {}, but got {}", uint64_t(64) * 4 * (wrap - 1), total);
+        return false;
+    }
+    return true;
+}
+
+bool test_series_store_reset()
+{
+    RaplSeriesStore store(1, 8);
+    const TimePoint start;
+    store.appendSample(start, {{10.0, 0.0, 0.0, 0.0}});
+    store.appendSample(start + std::chrono::seconds(1), {{10.0, 0.0, 0.0, 0.0}});
+    store.reset();
+    // ten seconds later, the power must not be computed over the gap before the reset
+    store.appendSample(start + std::chrono::seconds(11), {{5.0, 0.0, 0.0, 0.0}});
+    if (store.getCurrentPower(Domain::PKG) != 10.0 || store.getTotalEnergy(Domain::PKG) != 5.0)
+    {
+        LOG_ERROR("Unexpected power {} or energy {} after reset", store.getCurrentPower(Domain::PKG),
+                  store.getTotalEnergy(Domain::PKG));
+        return false;
+    }
+    store.appendSample(start + std::chrono::milliseconds(11500), {{5.0, 0.0, 0.0, 0.0}});
+    if (store.getCurrentPower(Domain::PKG) != 10.0 || store.size() != 2)
+    {
+        LOG_ERROR("Expected 10 W after reset, but got {}", store.getCurrentPower(Domain::PKG));
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    LOAD_ENV_LEVELS()
+    auto root = make_fake_powercap_tree();
+
+    CHECK(test_powercap_reader_domains(root));
+    CHECK(test_powercap_reader_missing_package(root));
+    CHECK(test_perf_reader_missing_pmu(root));
+    CHECK(test_state_sequence_wrap_ranges());
+    CHECK(test_extended_counter_synthetic_wraps());
+    CHECK(test_extended_counter_beyond_32_bits());
+    CHECK(test_series_store_reset());
+
+    fs::remove_all(root);
+    return 0;
+}
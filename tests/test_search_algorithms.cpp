@@ -0,0 +1,116 @@
+#include "eco.hpp"
+#include "../src/logging.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#define CHECK(x)                                                                                                       \
+    if (x != true)                                                                                                     \
+    {                                                                                                                  \
+        exit(-1);                                                                                                      \
+    }
+
+// one second window of an application whose performance saturates with the power cap
+static PowAndPerfResult make_result(double capInWatts)
+{
+    const double power = 20.0 + 0.8 * capInWatts;
+    const double instrPerSecond = 1e9 * (1.0 - std::exp(-power / 40.0));
+    return PowAndPerfResult(instrPerSecond, 1.0, capInWatts, power, power, 0.0, power);
+}
+
+bool test_bo_flat_posterior_keeps_default_cap()
+{
+    // e.g., plus metric observations which were never computed, all equal to the reference
+    GaussianProcess gp;
+    for (double x : {1.0, 0.2, 0.6, 0.4})
+    {
+        gp.addObservation(x, 1.0);
+    }
+    gp.fit();
+    const auto bestX = std::get<0>(BayesianOptimizationSearchAlgorithm::findPosteriorMinimum(gp));
+    if (bestX != 1.0)
+    {
+        LOG_ERROR("Flat posterior collapsed to the normalized cap {}", bestX);
+        return false;
+    }
+    return true;
+}
+
+bool test_bo_plus_metric_cost_finds_interior_minimum()
+{
+    const double minCap = 40.0, maxCap = 200.0;
+    auto toCap = [&](double x) { return minCap + x * (maxCap - minCap); };
+    const auto reference = make_result(maxCap);
+
+    double trueBestX = 1.0, trueBestCost = INFINITY;
+    for (int i = 0; i <= 100; i++)
+    {
+        const double cost = SearchAlgorithm::getCost(make_result(toCap(i / 100.0)), reference, TargetMetric::MIN_M_PLUS, 2.0);
+        if (cost < trueBestCost)
+        {
+            trueBestCost = cost;
+            trueBestX = i / 100.0;
+        }
+    }
+    if (trueBestX <= 0.05 || trueBestX >= 0.95)
+    {
+        LOG_ERROR("Synthetic plus metric has no interior minimum ({})", trueBestX);
+        return false;
+    }
+
+    GaussianProcess gp;
+    for (double x : {1.0, 0.0, 0.2, 0.4, 0.6, 0.8})
+    {
+        gp.addObservation(x, SearchAlgorithm::getCost(make_result(toCap(x)), reference, TargetMetric::MIN_M_PLUS, 2.0));
+    }
+    gp.fit();
+    const auto bestX = std::get<0>(BayesianOptimizationSearchAlgorithm::findPosteriorMinimum(gp));
+    if (std::abs(bestX - trueBestX) > 0.15)
+    {
+        LOG_ERROR("Expected the posterior minimum near {}, but got {}", trueBestX, bestX);
+        return false;
+    }
+    return true;
+}
+
+bool test_model_plus_metric_with_low_k_prefers_highest_power()
+{
+    std::vector<SaturatingPerformanceModel::Point> points;
+    for (double power : {40.0, 60.0, 80.0, 120.0})
+    {
+        const double x = power - 10.0;
+        points.push_back({power, 1e9 * x / (30.0 + x)});
+    }
+    const auto model = SaturatingPerformanceModel::fit(points, 10.0);
+    if (!model)
+    {
+        LOG_ERROR("Saturating model not fitted to the saturating points");
+        return false;
+    }
+    if (!std::isfinite(model->getOptimalPowerInWatts(TargetMetric::MIN_M_PLUS, 120.0, 2.0)))
+    {
+        LOG_ERROR("Expected a finite plus metric optimum for k = 2");
+        return false;
+    }
+    for (double k : {1.0, 0.5, 0.0})
+    {
+        const double optimalPower = model->getOptimalPowerInWatts(TargetMetric::MIN_M_PLUS, 120.0, k);
+        if (!(optimalPower == INFINITY))
+        {
+            LOG_ERROR("Expected the highest power to be optimal for k = {}, but got {}W", k, optimalPower);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    LOAD_ENV_LEVELS()
+
+    CHECK(test_bo_flat_posterior_keeps_default_cap());
+    CHECK(test_bo_plus_metric_cost_finds_interior_minimum());
+    CHECK(test_model_plus_metric_with_low_k_prefers_highest_power());
+
+    return 0;
+}